@@ -0,0 +1,189 @@
+// Copyright 2026 Henrik Steffen Gaßmann
+//
+// Distributed under the Boost Software License, Version 1.0.
+//         (See accompanying file LICENSE or copy at
+//           https://www.boost.org/LICENSE_1_0.txt)
+
+// Compares dplx::blake2s_hasher with SipHash, a keyed dplx_blake2s() call and
+// the unkeyed std::hash for short hash table keys.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <span>
+#include <string_view>
+
+#include <dplx/blake2.h>
+#include <dplx/blake2.hpp>
+
+namespace
+{
+
+// SipHash-c-d as specified by Aumasson and Bernstein with a 64 bit output
+template <int CompressionRounds, int FinalizationRounds>
+class siphash
+{
+    std::uint64_t mK0;
+    std::uint64_t mK1;
+
+public:
+    explicit siphash(std::span<std::byte const, 16U> key) noexcept
+        : mK0(load(key.data()))
+        , mK1(load(key.data() + 8U))
+    {
+    }
+
+    auto operator()(std::string_view data) const noexcept -> std::size_t
+    {
+        std::uint64_t v0 = mK0 ^ 0x736f'6d65'7073'6575U;
+        std::uint64_t v1 = mK1 ^ 0x646f'7261'6e64'6f6dU;
+        std::uint64_t v2 = mK0 ^ 0x6c79'6765'6e65'7261U;
+        std::uint64_t v3 = mK1 ^ 0x7465'6462'7974'6573U;
+        auto const round = [&] {
+            v0 += v1;
+            v1 = std::rotl(v1, 13) ^ v0;
+            v0 = std::rotl(v0, 32);
+            v2 += v3;
+            v3 = std::rotl(v3, 16) ^ v2;
+            v0 += v3;
+            v3 = std::rotl(v3, 21) ^ v0;
+            v2 += v1;
+            v1 = std::rotl(v1, 17) ^ v2;
+            v2 = std::rotl(v2, 32);
+        };
+
+        auto const *in = reinterpret_cast<std::byte const *>(data.data());
+        std::size_t const size = data.size();
+        std::size_t const tail = size % 8U;
+        for (auto const *end = in + (size - tail); in != end; in += 8)
+        {
+            std::uint64_t const m = load(in);
+            v3 ^= m;
+            for (int i = 0; i < CompressionRounds; ++i)
+            {
+                round();
+            }
+            v0 ^= m;
+        }
+
+        std::uint64_t last = static_cast<std::uint64_t>(size) << 56U;
+        for (std::size_t i = 0; i < tail; ++i)
+        {
+            last |= static_cast<std::uint64_t>(in[i]) << (8U * i);
+        }
+        v3 ^= last;
+        for (int i = 0; i < CompressionRounds; ++i)
+        {
+            round();
+        }
+        v0 ^= last;
+
+        v2 ^= 0xFFU;
+        for (int i = 0; i < FinalizationRounds; ++i)
+        {
+            round();
+        }
+        return static_cast<std::size_t>(v0 ^ v1 ^ v2 ^ v3);
+    }
+
+private:
+    static auto load(std::byte const *in) noexcept -> std::uint64_t
+    {
+        std::uint64_t value = 0U;
+        for (std::size_t i = 0; i < 8U; ++i)
+        {
+            value |= static_cast<std::uint64_t>(in[i]) << (8U * i);
+        }
+        return value;
+    }
+};
+
+class blake2s_oneshot
+{
+    std::span<std::byte const, 16U> mKey;
+
+public:
+    explicit blake2s_oneshot(std::span<std::byte const, 16U> key) noexcept
+        : mKey(key)
+    {
+    }
+
+    auto operator()(std::string_view data) const noexcept -> std::size_t
+    {
+        std::size_t value = 0U;
+        (void)dplx_blake2s(&value, sizeof(value), data.data(), data.size(),
+                           mKey.data(), mKey.size());
+        return value;
+    }
+};
+
+constexpr int trials = 32;
+constexpr int iterations = 20'000;
+
+// median time per hash in nanoseconds of data.size() - 1 bytes
+template <typename Hasher>
+auto bench(Hasher const &hasher, std::string_view data) -> double
+{
+    std::size_t const size = data.size() - 1U;
+    std::array<double, trials> samples{};
+    std::size_t sink = 0U;
+    for (auto &sample : samples)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            // make each input depend on the last result
+            sink += hasher(data.substr(sink & 1U, size));
+        }
+        std::chrono::duration<double, std::nano> const elapsed
+                = std::chrono::steady_clock::now() - start;
+        sample = elapsed.count() / iterations;
+    }
+    if (sink == 1U)
+    {
+        std::puts("");
+    }
+    std::ranges::sort(samples);
+    return samples[trials / 2];
+}
+
+} // namespace
+
+auto main() -> int
+{
+    std::array<std::byte, 16U> key{};
+    for (std::size_t i = 0; i < key.size(); ++i)
+    {
+        key[i] = static_cast<std::byte>(i);
+    }
+    std::span<std::byte const, 16U> const keyView(key);
+
+    std::array<char, 256U + 1U> in{};
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = static_cast<char>('a' + (i % 26U));
+    }
+
+    dplx::blake2s_hasher const blake2sHasher(keyView);
+    blake2s_oneshot const blake2sOneshot(keyView);
+    siphash<2, 4> const siphash24(keyView);
+    siphash<1, 3> const siphash13(keyView);
+    std::hash<std::string_view> const stdHash{};
+
+    std::printf("#bytes  blake2s_hasher  dplx_blake2s  siphash-2-4  "
+                "siphash-1-3  std::hash   [ns/hash]\n");
+    for (std::size_t const size : {8U, 16U, 24U, 32U, 48U, 64U, 128U, 256U})
+    {
+        std::string_view const data(in.data(), size + 1U);
+        std::printf("%6zu  %14.2f  %12.2f  %11.2f  %11.2f  %9.2f\n", size,
+                    bench(blake2sHasher, data), bench(blake2sOneshot, data),
+                    bench(siphash24, data), bench(siphash13, data),
+                    bench(stdHash, data));
+    }
+    return 0;
+}
@@ -30,10 +30,15 @@ target_sources(libb2-reforged
         src/blake2.h
         src/dplx/blake2.h
         src/dplx/blake2/detail/blake2-impl.h
+        src/dplx/blake2/detail/blake2-state-io.c
         src/dplx/blake2/detail/blake2b-common.c.inc
+        src/dplx/blake2/detail/blake2bp-common.c.inc
+        src/dplx/blake2/detail/blake2b-many.c.inc
         src/dplx/blake2/detail/blake2s-common.c.inc
-        src/dplx/blake2/detail/blake2xb-generic.c
-        src/dplx/blake2/detail/blake2xs-generic.c
+        src/dplx/blake2/detail/blake2sp-common.c.inc
+        src/dplx/blake2/detail/blake2s-many.c.inc
+        src/dplx/blake2/detail/blake2xb-common.c.inc
+        src/dplx/blake2/detail/blake2xs-common.c.inc
 )
 
 set(DISPATCH_DEFS "")
@@ -62,20 +67,26 @@ else()
             src/dplx/blake2/detail/blake2-dispatch.c
 
         PROPERTIES
-            COMPILE_FLAGS "$<$<IN_LIST:AVX,${ACTIVE_IMPLEMENTATIONS}>:${DPLX_BLAKE2_CFLAGS_XSAVE}>"
-            COMPILE_DEFINITIONS "${DISPATCH_DEFS}"
+            COMPILE_FLAGS "$<$<OR:$<IN_LIST:AVX,${ACTIVE_IMPLEMENTATIONS}>,$<IN_LIST:XOP,${ACTIVE_IMPLEMENTATIONS}>,$<IN_LIST:AVX2,${ACTIVE_IMPLEMENTATIONS}>,$<IN_LIST:AVX512,${ACTIVE_IMPLEMENTATIONS}>>:${DPLX_BLAKE2_CFLAGS_XSAVE}>"
+            COMPILE_DEFINITIONS "${DISPATCH_DEFS};DPLX_BLAKE2_DISPATCH_IFUNC=$<BOOL:${DPLX_BLAKE2_WITH_IFUNC}>"
     )
 
 endif()
 if ("SSE2" IN_LIST ACTIVE_IMPLEMENTATIONS
+    OR "SSSE3" IN_LIST ACTIVE_IMPLEMENTATIONS
     OR "SSE41" IN_LIST ACTIVE_IMPLEMENTATIONS
-    OR "AVX" IN_LIST ACTIVE_IMPLEMENTATIONS)
+    OR "AVX" IN_LIST ACTIVE_IMPLEMENTATIONS
+    OR "XOP" IN_LIST ACTIVE_IMPLEMENTATIONS
+    OR "AVX2" IN_LIST ACTIVE_IMPLEMENTATIONS
+    OR "AVX512" IN_LIST ACTIVE_IMPLEMENTATIONS)
 
     target_sources(libb2-reforged
         PRIVATE
             src/dplx/blake2/detail/blake2-x86-config.h
             src/dplx/blake2/detail/blake2b-x86-round.h
+            src/dplx/blake2/detail/blake2b-x86-lanes.h
             src/dplx/blake2/detail/blake2s-x86-round.h
+            src/dplx/blake2/detail/blake2s-x86-lanes.h
 
             src/dplx/blake2/detail/blake2b-sse2-load.h
             src/dplx/blake2/detail/blake2b-sse41-load.h
@@ -83,14 +94,27 @@ if ("SSE2" IN_LIST ACTIVE_IMPLEMENTATIONS
             src/dplx/blake2/detail/blake2s-sse41-load.h
     )
 endif()
+if ("AVX2" IN_LIST ACTIVE_IMPLEMENTATIONS
+    OR "AVX512" IN_LIST ACTIVE_IMPLEMENTATIONS)
+
+    target_sources(libb2-reforged
+        PRIVATE
+            src/dplx/blake2/detail/blake2b-avx2-load.h
+            src/dplx/blake2/detail/blake2b-avx2-round.h
+            src/dplx/blake2/detail/blake2b-avx2-lanes.h
+            src/dplx/blake2/detail/blake2s-avx2-lanes.h
+    )
+endif()
 if ("NEON" IN_LIST ACTIVE_IMPLEMENTATIONS)
 
     target_sources(libb2-reforged
         PRIVATE
             src/dplx/blake2/detail/blake2b-neon-load.h
             src/dplx/blake2/detail/blake2b-neon-round.h
+            src/dplx/blake2/detail/blake2b-neon-lanes.h
             src/dplx/blake2/detail/blake2s-neon-load.h
             src/dplx/blake2/detail/blake2s-neon-round.h
+            src/dplx/blake2/detail/blake2s-neon-lanes.h
     )
 endif()
 foreach(IMPL IMPL_FILE_PART IN ZIP_LISTS ACTIVE_IMPLEMENTATIONS ACTIVE_IMPLEMENTATION_FILE_PARTS)
@@ -48,6 +48,9 @@ extern "C" {
   typedef struct dplx_blake2s_param blake2s_param;
   typedef struct dplx_blake2b_param blake2b_param;
 
+  typedef struct dplx_blake2sp_state blake2sp_state;
+  typedef struct dplx_blake2bp_state blake2bp_state;
+
   typedef struct dplx_blake2xs_state blake2xs_state;
   typedef struct dplx_blake2xb_state blake2xb_state;
 
@@ -58,12 +61,22 @@ extern "C" {
   DPLX_BLAKE2_EXPORT int blake2s_update( blake2s_state *S, const void *in, size_t inlen );
   DPLX_BLAKE2_EXPORT int blake2s_final( blake2s_state *S, void *out, size_t outlen );
 
+  DPLX_BLAKE2_EXPORT int blake2sp_init( blake2sp_state *S, size_t outlen );
+  DPLX_BLAKE2_EXPORT int blake2sp_init_key( blake2sp_state *S, size_t outlen, const void *key, size_t keylen );
+  DPLX_BLAKE2_EXPORT int blake2sp_update( blake2sp_state *S, const void *in, size_t inlen );
+  DPLX_BLAKE2_EXPORT int blake2sp_final( blake2sp_state *S, void *out, size_t outlen );
+
   DPLX_BLAKE2_EXPORT int blake2b_init( blake2b_state *S, size_t outlen );
   DPLX_BLAKE2_EXPORT int blake2b_init_key( blake2b_state *S, size_t outlen, const void *key, size_t keylen );
   DPLX_BLAKE2_EXPORT int blake2b_init_param( blake2b_state *S, const blake2b_param *P );
   DPLX_BLAKE2_EXPORT int blake2b_update( blake2b_state *S, const void *in, size_t inlen );
   DPLX_BLAKE2_EXPORT int blake2b_final( blake2b_state *S, void *out, size_t outlen );
 
+  DPLX_BLAKE2_EXPORT int blake2bp_init( blake2bp_state *S, size_t outlen );
+  DPLX_BLAKE2_EXPORT int blake2bp_init_key( blake2bp_state *S, size_t outlen, const void *key, size_t keylen );
+  DPLX_BLAKE2_EXPORT int blake2bp_update( blake2bp_state *S, const void *in, size_t inlen );
+  DPLX_BLAKE2_EXPORT int blake2bp_final( blake2bp_state *S, void *out, size_t outlen );
+
   /* Variable output length API */
   DPLX_BLAKE2_EXPORT int blake2xs_init( blake2xs_state *S, const size_t outlen );
   DPLX_BLAKE2_EXPORT int blake2xs_init_key( blake2xs_state *S, const size_t outlen, const void *key, size_t keylen );
@@ -79,6 +92,9 @@ extern "C" {
   DPLX_BLAKE2_EXPORT int blake2s( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
   DPLX_BLAKE2_EXPORT int blake2b( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
 
+  DPLX_BLAKE2_EXPORT int blake2sp( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
+  DPLX_BLAKE2_EXPORT int blake2bp( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
+
   DPLX_BLAKE2_EXPORT int blake2xs( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
   DPLX_BLAKE2_EXPORT int blake2xb( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
 
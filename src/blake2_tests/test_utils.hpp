@@ -7,6 +7,12 @@
 
 #pragma once
 
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
 #ifdef __GNUC__
 #pragma GCC diagnostic ignored "-Wmissing-declarations"
 #endif
@@ -20,4 +26,30 @@ namespace blake2_tests
 
 using namespace dplx;
 
+// fills the given buffer with the non-repeating test input pattern
+constexpr void fill_test_input(std::span<std::uint8_t> const out) noexcept
+{
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        out[i] = static_cast<std::uint8_t>(i * 7U);
+    }
+}
+constexpr void fill_test_input(std::span<std::byte> const out) noexcept
+{
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        out[i] = static_cast<std::byte>(i * 7U);
+    }
+}
+
+// returns size bytes of the test input pattern
+template <typename Byte = std::uint8_t>
+    requires std::same_as<Byte, std::uint8_t> || std::same_as<Byte, std::byte>
+auto make_test_input(std::size_t const size) -> std::vector<Byte>
+{
+    std::vector<Byte> in(size);
+    fill_test_input(std::span<Byte>(in));
+    return in;
 }
+
+} // namespace blake2_tests
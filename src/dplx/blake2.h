@@ -20,6 +20,7 @@
 
 #if !defined(__cplusplus) && __STDC_VERSION__ < 202311l
 #include <assert.h>
+#include <stdalign.h>
 #include <stdbool.h>
 #endif
 
@@ -53,6 +54,22 @@ extern "C" {
     DPLX_BLAKE2B_PERSONALBYTES = 16
   };
 
+  /* size of the child digests combined by dplx_blake2{s,b}_hash_pair() */
+  enum dplx_blake2_pair_constant
+  {
+    DPLX_BLAKE2_CHILDBYTES = 32
+  };
+
+  /* sizes of the serialized hash states, see dplx_blake2b_state_export() */
+  enum dplx_blake2_state_format
+  {
+    DPLX_BLAKE2_STATE_FORMAT_VERSION = 1,
+    DPLX_BLAKE2S_STATEBYTES  = 117,
+    DPLX_BLAKE2B_STATEBYTES  = 229,
+    DPLX_BLAKE2XS_STATEBYTES = 157,
+    DPLX_BLAKE2XB_STATEBYTES = 301
+  };
+
   typedef struct dplx_blake2s_state
   {
     uint32_t h[8];
@@ -113,31 +130,134 @@ extern "C" {
   typedef struct dplx_blake2b_param dplx_blake2b_param;
   static_assert(sizeof(dplx_blake2b_param) == DPLX_BLAKE2B_OUTBYTES, "dplx_blake2b_param must not be padded");
 
+  typedef struct dplx_blake2sp_state
+  {
+    dplx_blake2s_state S[8][1];
+    dplx_blake2s_state R[1];
+    uint8_t  buf[8 * DPLX_BLAKE2S_BLOCKBYTES];
+    size_t   buflen;
+    size_t   outlen;
+  } dplx_blake2sp_state;
+
+  typedef struct dplx_blake2bp_state
+  {
+    dplx_blake2b_state S[4][1];
+    dplx_blake2b_state R[1];
+    uint8_t  buf[4 * DPLX_BLAKE2B_BLOCKBYTES];
+    size_t   buflen;
+    size_t   outlen;
+  } dplx_blake2bp_state;
+
+  typedef struct dplx_blake2s_job
+  {
+    void       *out;
+    size_t      outlen;
+    const void *in;
+    size_t      inlen;
+    const void *key;
+    size_t      keylen;
+  } dplx_blake2s_job;
+
+  typedef struct dplx_blake2b_job
+  {
+    void       *out;
+    size_t      outlen;
+    const void *in;
+    size_t      inlen;
+    const void *key;
+    size_t      keylen;
+  } dplx_blake2b_job;
+
+  /* state without an input buffer for applications which keep a large number
+     of hash computations in flight, see dplx_blake2{s,b}_compact_update() */
+  typedef struct dplx_blake2s_compact_state
+  {
+    alignas(64) uint32_t h[8];
+    uint32_t t[2];
+    uint8_t  outlen;
+    uint8_t  last_node;
+    uint8_t  last_block;
+  } dplx_blake2s_compact_state;
+  static_assert(sizeof(dplx_blake2s_compact_state) == 64, "dplx_blake2s_compact_state must fit into a cache line");
+
+  typedef struct dplx_blake2b_compact_state
+  {
+    alignas(64) uint64_t h[8];
+    uint64_t t[2];
+    uint8_t  outlen;
+    uint8_t  last_node;
+    uint8_t  last_block;
+  } dplx_blake2b_compact_state;
+  static_assert(sizeof(dplx_blake2b_compact_state) == 128, "dplx_blake2b_compact_state must fit into two cache lines");
+
+  /* state after keying, see dplx_blake2{s,b}_prepare_key() */
+  typedef struct dplx_blake2s_prepared_key
+  {
+    dplx_blake2s_state S[1];
+    uint32_t h[8];
+  } dplx_blake2s_prepared_key;
+
+  typedef struct dplx_blake2b_prepared_key
+  {
+    dplx_blake2b_state S[1];
+    uint64_t h[8];
+  } dplx_blake2b_prepared_key;
+
+  /* layout compatible with the POSIX struct iovec */
+  typedef struct dplx_blake2_iovec
+  {
+    const void *iov_base;
+    size_t      iov_len;
+  } dplx_blake2_iovec;
+
   typedef struct dplx_blake2xs_state
   {
     dplx_blake2s_state S[1];
     dplx_blake2s_param P[1];
+    uint64_t squeezed;
   } dplx_blake2xs_state;
 
   typedef struct dplx_blake2xb_state
   {
     dplx_blake2b_state S[1];
     dplx_blake2b_param P[1];
+    uint64_t squeezed;
   } dplx_blake2xb_state;
 
 
-  /* Streaming API */
+  /* Streaming API
+     dplx_blake2{s,b}_updatev() absorbs the concatenation of n input fragments,
+     blocks are only assembled in the state where they span fragments.
+
+     dplx_blake2{s,b}_final_with_data() absorbs the remaining input and
+     finalizes the hash. In contrast to a dplx_blake2{s,b}_update() call
+     followed by dplx_blake2{s,b}_final() a complete last block is never copied
+     into the state, i.e. block aligned input is hashed without staging. */
   DPLX_BLAKE2_EXPORT int dplx_blake2s_init( dplx_blake2s_state *S, size_t outlen );
   DPLX_BLAKE2_EXPORT int dplx_blake2s_init_key( dplx_blake2s_state *S, size_t outlen, const void *key, size_t keylen );
   DPLX_BLAKE2_EXPORT int dplx_blake2s_init_param( dplx_blake2s_state *S, const dplx_blake2s_param *P );
   DPLX_BLAKE2_EXPORT int dplx_blake2s_update( dplx_blake2s_state *S, const void *in, size_t inlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_updatev( dplx_blake2s_state *S, const dplx_blake2_iovec *iov, size_t n );
   DPLX_BLAKE2_EXPORT int dplx_blake2s_final( dplx_blake2s_state *S, void *out, size_t outlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_final_with_data( dplx_blake2s_state *S, const void *in, size_t inlen, void *out, size_t outlen );
+
+  DPLX_BLAKE2_EXPORT int dplx_blake2sp_init( dplx_blake2sp_state *S, size_t outlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2sp_init_key( dplx_blake2sp_state *S, size_t outlen, const void *key, size_t keylen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2sp_update( dplx_blake2sp_state *S, const void *in, size_t inlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2sp_final( dplx_blake2sp_state *S, void *out, size_t outlen );
 
   DPLX_BLAKE2_EXPORT int dplx_blake2b_init( dplx_blake2b_state *S, size_t outlen );
   DPLX_BLAKE2_EXPORT int dplx_blake2b_init_key( dplx_blake2b_state *S, size_t outlen, const void *key, size_t keylen );
   DPLX_BLAKE2_EXPORT int dplx_blake2b_init_param( dplx_blake2b_state *S, const dplx_blake2b_param *P );
   DPLX_BLAKE2_EXPORT int dplx_blake2b_update( dplx_blake2b_state *S, const void *in, size_t inlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_updatev( dplx_blake2b_state *S, const dplx_blake2_iovec *iov, size_t n );
   DPLX_BLAKE2_EXPORT int dplx_blake2b_final( dplx_blake2b_state *S, void *out, size_t outlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_final_with_data( dplx_blake2b_state *S, const void *in, size_t inlen, void *out, size_t outlen );
+
+  DPLX_BLAKE2_EXPORT int dplx_blake2bp_init( dplx_blake2bp_state *S, size_t outlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2bp_init_key( dplx_blake2bp_state *S, size_t outlen, const void *key, size_t keylen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2bp_update( dplx_blake2bp_state *S, const void *in, size_t inlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2bp_final( dplx_blake2bp_state *S, void *out, size_t outlen );
 
   /* Variable output length API */
   DPLX_BLAKE2_EXPORT int dplx_blake2xs_init( dplx_blake2xs_state *S, const size_t outlen );
@@ -150,13 +270,107 @@ extern "C" {
   DPLX_BLAKE2_EXPORT int dplx_blake2xb_update( dplx_blake2xb_state *S, const void *in, size_t inlen );
   DPLX_BLAKE2_EXPORT int dplx_blake2xb_final(dplx_blake2xb_state *S, void *out, size_t outlen);
 
+  /* Random access output API
+     Writes the bytes [offset, offset + outlen) of the output. The first call
+     finalizes the root hash, afterwards no further input may be added and
+     any range can be read in any order. Fails if the range exceeds the
+     xof_length given to init. An output of unknown length is an unbounded
+     stream of full blocks, i.e. its last block only matches the one of
+     dplx_blake2x{s,b}_final() if that was called with a multiple of the block
+     size. */
+  DPLX_BLAKE2_EXPORT int dplx_blake2xs_squeeze_at( dplx_blake2xs_state *S, uint64_t offset, void *out, size_t outlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2xb_squeeze_at( dplx_blake2xb_state *S, uint64_t offset, void *out, size_t outlen );
+
+  /* Incremental output API
+     Writes the next outlen bytes of the output, i.e. consecutive calls read
+     the output as a stream in caller sized chunks. The output is defined like
+     the one of dplx_blake2x{s,b}_squeeze_at() and fails once the xof_length
+     given to init would be exceeded. */
+  DPLX_BLAKE2_EXPORT int dplx_blake2xs_squeeze( dplx_blake2xs_state *S, void *out, size_t outlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2xb_squeeze( dplx_blake2xb_state *S, void *out, size_t outlen );
+
   /* Simple API */
   DPLX_BLAKE2_EXPORT int dplx_blake2s( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
   DPLX_BLAKE2_EXPORT int dplx_blake2b( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
 
+  DPLX_BLAKE2_EXPORT int dplx_blake2sp( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2bp( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
+
   DPLX_BLAKE2_EXPORT int dplx_blake2xs( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
   DPLX_BLAKE2_EXPORT int dplx_blake2xb( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
 
+  /* Multi-buffer API
+     Computes dplx_blake2s() / dplx_blake2b() for each job. Fails without
+     writing any output if the parameters of any job are invalid. */
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_many( const dplx_blake2s_job *jobs, size_t n );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_many( const dplx_blake2b_job *jobs, size_t n );
+
+  /* State serialization API
+     Writes the state in a versioned, endian and platform independent format
+     of DPLX_BLAKE2{S,B,XS,XB}_STATEBYTES, so that a computation can be
+     resumed by a different process or build. Importing fails for states of a
+     different algorithm or format version. */
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_state_export( const dplx_blake2s_state *S, void *out );
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_state_import( dplx_blake2s_state *S, const void *in );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_state_export( const dplx_blake2b_state *S, void *out );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_state_import( dplx_blake2b_state *S, const void *in );
+  DPLX_BLAKE2_EXPORT int dplx_blake2xs_state_export( const dplx_blake2xs_state *S, void *out );
+  DPLX_BLAKE2_EXPORT int dplx_blake2xs_state_import( dplx_blake2xs_state *S, const void *in );
+  DPLX_BLAKE2_EXPORT int dplx_blake2xb_state_export( const dplx_blake2xb_state *S, void *out );
+  DPLX_BLAKE2_EXPORT int dplx_blake2xb_state_import( dplx_blake2xb_state *S, const void *in );
+
+  /* Compact state API
+     The compact states don't buffer any input: dplx_blake2{s,b}_compact_update()
+     only accepts whole blocks and the last block of the message, which may be
+     a whole block as well, has to be passed to dplx_blake2{s,b}_compact_final().
+     Only an empty message may be finalized without any input.
+     The states are aligned to 64 bytes, i.e. heap allocated states need storage
+     from aligned_alloc(64, ...) or an equivalent, because malloc() only
+     guarantees the alignment of max_align_t. */
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_compact_init( dplx_blake2s_compact_state *C, size_t outlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_compact_update( dplx_blake2s_compact_state *C, const void *in, size_t inlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_compact_final( dplx_blake2s_compact_state *C, const void *in, size_t inlen, void *out, size_t outlen );
+
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_compact_init( dplx_blake2b_compact_state *C, size_t outlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_compact_update( dplx_blake2b_compact_state *C, const void *in, size_t inlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_compact_final( dplx_blake2b_compact_state *C, const void *in, size_t inlen, void *out, size_t outlen );
+
+  /* Prepared key API
+     dplx_blake2{s,b}_prepare_key() performs dplx_blake2{s,b}_init_key() once
+     and precomputes the compression of the key block, so that messages
+     authenticated with a long-lived key skip both.
+     dplx_blake2{s,b}_init_prepared() starts a streaming computation with the
+     prepared key. dplx_blake2{s,b}_mac() and dplx_blake2{s,b}_mac_many() are the
+     one-shot and multi-buffer counterparts; the jobs mustn't specify a key and
+     their outlen must match the prepared one. */
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_prepare_key( dplx_blake2s_prepared_key *K, size_t outlen, const void *key, size_t keylen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_init_prepared( dplx_blake2s_state *S, const dplx_blake2s_prepared_key *K );
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_mac( const dplx_blake2s_prepared_key *K, void *out, size_t outlen, const void *in, size_t inlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_mac_many( const dplx_blake2s_prepared_key *K, const dplx_blake2s_job *jobs, size_t n );
+
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_prepare_key( dplx_blake2b_prepared_key *K, size_t outlen, const void *key, size_t keylen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_init_prepared( dplx_blake2b_state *S, const dplx_blake2b_prepared_key *K );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_mac( const dplx_blake2b_prepared_key *K, void *out, size_t outlen, const void *in, size_t inlen );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_mac_many( const dplx_blake2b_prepared_key *K, const dplx_blake2b_job *jobs, size_t n );
+
+  /* Compression function API
+     Applies the compression function to the chaining value h and the given
+     message block with the counter t and the finalization flags f. Allows
+     building custom modes on top of the dispatched implementations. */
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_compress( uint32_t h[8], const void *block, const uint32_t t[2], const uint32_t f[2] );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_compress( uint64_t h[8], const void *block, const uint64_t t[2], const uint64_t f[2] );
+
+  /* Merkle tree API
+     dplx_blake2{s,b}_hash_pair() computes the unkeyed hash of the concatenation
+     of two DPLX_BLAKE2_CHILDBYTES digests, i.e. of a single message block.
+     dplx_blake2{s,b}_hash_pairs() hashes n such pairs stored consecutively in
+     children, e.g. a tree level, and writes n digests of outlen bytes to out.
+     out may be equal to children in order to reduce a level in place. */
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_hash_pair( void *out, size_t outlen, const void *left, const void *right );
+  DPLX_BLAKE2_EXPORT int dplx_blake2s_hash_pairs( void *out, size_t outlen, const void *children, size_t n );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_hash_pair( void *out, size_t outlen, const void *left, const void *right );
+  DPLX_BLAKE2_EXPORT int dplx_blake2b_hash_pairs( void *out, size_t outlen, const void *children, size_t n );
+
   enum dplx_blake2_implementation_id
   {
     DPLX_BLAKE2_IMPL_FALLBACK,
@@ -165,12 +379,65 @@ extern "C" {
     DPLX_BLAKE2_IMPL_SSE2,
     DPLX_BLAKE2_IMPL_SSE41,
     DPLX_BLAKE2_IMPL_AVX,
+    DPLX_BLAKE2_IMPL_AVX2,
+    DPLX_BLAKE2_IMPL_AVX512,
+    DPLX_BLAKE2_IMPL_SSSE3,
+    DPLX_BLAKE2_IMPL_XOP,
     DPLX_BLAKE2_IMPL_COUNT,
   };
 
+  enum dplx_blake2_algorithm
+  {
+    DPLX_BLAKE2_ALGORITHM_B,  /* BLAKE2b streaming & simple API */
+    DPLX_BLAKE2_ALGORITHM_S,  /* BLAKE2s streaming & simple API */
+    DPLX_BLAKE2_ALGORITHM_BP, /* BLAKE2bp and the BLAKE2b multi-buffer API */
+    DPLX_BLAKE2_ALGORITHM_SP, /* BLAKE2sp and the BLAKE2s multi-buffer API */
+    DPLX_BLAKE2_ALGORITHM_COUNT,
+  };
+
+  /* the input length classes distinguished by dplx_blake2_autotune() */
+  enum dplx_blake2_size_class
+  {
+    DPLX_BLAKE2_SIZE_SMALL,  /* up to 256 bytes */
+    DPLX_BLAKE2_SIZE_MEDIUM, /* up to 16 KiB */
+    DPLX_BLAKE2_SIZE_LARGE,
+    DPLX_BLAKE2_SIZE_CLASS_COUNT,
+  };
+
+  /* An implementation is available if it has been compiled in and the
+     executing processor supports the instruction set extensions it uses.
+     If the library has been built with DPLX_BLAKE2_WITH_IFUNC, the dynamic
+     loader permanently binds the most capable implementation instead. Only
+     that one and DPLX_BLAKE2_IMPL_FALLBACK are available then, i.e.
+     dplx_blake2_use_implementation() returns -1 for any other and
+     DPLX_BLAKE2_IMPL is ignored. */
   DPLX_BLAKE2_EXPORT int dplx_blake2_choose_implementation( void );
   DPLX_BLAKE2_EXPORT int dplx_blake2_use_implementation( enum dplx_blake2_implementation_id which );
   DPLX_BLAKE2_EXPORT bool dplx_blake2_has_implementation( enum dplx_blake2_implementation_id which );
+  /* Returns the implementation processing small BLAKE2b inputs. Unless one
+     has been selected explicitly, this is the implementation named by the
+     DPLX_BLAKE2_IMPL environment variable at the time of the first call, e.g.
+     DPLX_BLAKE2_IMPL=sse41, or else the most capable available one.
+     DPLX_BLAKE2_IMPL_FALLBACK is never reported, it is an alias of the default
+     implementation which is reported instead. */
+  DPLX_BLAKE2_EXPORT enum dplx_blake2_implementation_id dplx_blake2_current_implementation( void );
+  /* Returns the short name of an implementation, e.g. "sse41" as accepted by
+     DPLX_BLAKE2_IMPL, or NULL if the id is invalid. */
+  DPLX_BLAKE2_EXPORT const char *dplx_blake2_implementation_name( enum dplx_blake2_implementation_id which );
+  /* Returns the implementation with the given short name, i.e. the inverse of
+     dplx_blake2_implementation_name(), or DPLX_BLAKE2_IMPL_COUNT if the name is
+     unknown. This is the lookup applied to DPLX_BLAKE2_IMPL. */
+  DPLX_BLAKE2_EXPORT enum dplx_blake2_implementation_id dplx_blake2_implementation_from_name( const char *name );
+
+  /* Measures the available implementations of each algorithm for each size
+     class and installs the fastest ones. The update and simple functions then
+     select the implementation based on the input length. Takes in the order of
+     100ms. An implementation selected afterwards replaces the tuning results.
+     Returns -1 if the library has been built with DPLX_BLAKE2_WITH_IFUNC. */
+  DPLX_BLAKE2_EXPORT int dplx_blake2_autotune( void );
+  /* Returns the implementation processing inputs of the given size class or
+     DPLX_BLAKE2_IMPL_COUNT if the arguments are invalid. */
+  DPLX_BLAKE2_EXPORT enum dplx_blake2_implementation_id dplx_blake2_tuned_implementation( enum dplx_blake2_algorithm alg, enum dplx_blake2_size_class size );
 
 #if defined(__cplusplus)
 }
@@ -1,4 +1,3 @@
-
 // Copyright 2025 Henrik Steffen Gaßmann
 //
 // Distributed under the Boost Software License, Version 1.0.
@@ -7,4 +6,524 @@
 
 #pragma once
 
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
 #include <dplx/blake2/config.hpp>
+#include <dplx/blake2.h>
+
+namespace dplx
+{
+
+namespace detail
+{
+
+struct blake2s_traits
+{
+    using state_type = dplx_blake2s_state;
+    using word_type = std::uint32_t;
+
+    static constexpr std::size_t block_size = DPLX_BLAKE2S_BLOCKBYTES;
+    static constexpr std::size_t max_digest_size = DPLX_BLAKE2S_OUTBYTES;
+    static constexpr std::size_t max_key_size = DPLX_BLAKE2S_KEYBYTES;
+
+    static constexpr unsigned rounds = 10U;
+    static constexpr std::array<int, 4> rotations{16, 12, 8, 7};
+
+    static constexpr std::array<word_type, 8> iv{
+            0x6A09'E667U, 0xBB67'AE85U, 0x3C6E'F372U, 0xA54F'F53AU,
+            0x510E'527FU, 0x9B05'688CU, 0x1F83'D9ABU, 0x5BE0'CD19U,
+    };
+
+    static void init_key(state_type *state,
+                         std::size_t digestSize,
+                         void const *key,
+                         std::size_t keySize) noexcept
+    {
+        (void)dplx_blake2s_init_key(state, digestSize, key, keySize);
+    }
+    static void
+    update(state_type *state, void const *data, std::size_t size) noexcept
+    {
+        (void)dplx_blake2s_update(state, data, size);
+    }
+    static void final(state_type *state, void *out, std::size_t size) noexcept
+    {
+        (void)dplx_blake2s_final(state, out, size);
+    }
+    static void hash_pair(void *out,
+                          std::size_t size,
+                          void const *left,
+                          void const *right) noexcept
+    {
+        (void)dplx_blake2s_hash_pair(out, size, left, right);
+    }
+};
+
+struct blake2b_traits
+{
+    using state_type = dplx_blake2b_state;
+    using word_type = std::uint64_t;
+
+    static constexpr std::size_t block_size = DPLX_BLAKE2B_BLOCKBYTES;
+    static constexpr std::size_t max_digest_size = DPLX_BLAKE2B_OUTBYTES;
+    static constexpr std::size_t max_key_size = DPLX_BLAKE2B_KEYBYTES;
+
+    static constexpr unsigned rounds = 12U;
+    static constexpr std::array<int, 4> rotations{32, 24, 16, 63};
+
+    static constexpr std::array<word_type, 8> iv{
+            0x6A09'E667'F3BC'C908U, 0xBB67'AE85'84CA'A73BU,
+            0x3C6E'F372'FE94'F82BU, 0xA54F'F53A'5F1D'36F1U,
+            0x510E'527F'ADE6'82D1U, 0x9B05'688C'2B3E'6C1FU,
+            0x1F83'D9AB'FB41'BD6BU, 0x5BE0'CD19'137E'2179U,
+    };
+
+    static void init_key(state_type *state,
+                         std::size_t digestSize,
+                         void const *key,
+                         std::size_t keySize) noexcept
+    {
+        (void)dplx_blake2b_init_key(state, digestSize, key, keySize);
+    }
+    static void
+    update(state_type *state, void const *data, std::size_t size) noexcept
+    {
+        (void)dplx_blake2b_update(state, data, size);
+    }
+    static void final(state_type *state, void *out, std::size_t size) noexcept
+    {
+        (void)dplx_blake2b_final(state, out, size);
+    }
+    static void hash_pair(void *out,
+                          std::size_t size,
+                          void const *left,
+                          void const *right) noexcept
+    {
+        (void)dplx_blake2b_hash_pair(out, size, left, right);
+    }
+};
+
+// A portable rendition of the sequential hash which can be used during
+// constant evaluation. It mirrors the buffering of the C implementation, i.e.
+// the states are interchangeable.
+inline constexpr std::array<std::array<std::uint8_t, 16>, 10> blake2_sigma{{
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+        {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+        {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4},
+        {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+        {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13},
+        {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+        {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11},
+        {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+        {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5},
+        {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+}};
+
+template <typename Traits, typename Word>
+constexpr void blake2_mix(std::array<Word, 16> &v,
+                          std::size_t a,
+                          std::size_t b,
+                          std::size_t c,
+                          std::size_t d,
+                          Word x,
+                          Word y) noexcept
+{
+    constexpr auto const &r = Traits::rotations;
+    v[a] = v[a] + v[b] + x;
+    v[d] = std::rotr(static_cast<Word>(v[d] ^ v[a]), r[0]);
+    v[c] = v[c] + v[d];
+    v[b] = std::rotr(static_cast<Word>(v[b] ^ v[c]), r[1]);
+    v[a] = v[a] + v[b] + y;
+    v[d] = std::rotr(static_cast<Word>(v[d] ^ v[a]), r[2]);
+    v[c] = v[c] + v[d];
+    v[b] = std::rotr(static_cast<Word>(v[b] ^ v[c]), r[3]);
+}
+
+template <typename Traits>
+constexpr void blake2_compress(typename Traits::state_type &state,
+                               std::uint8_t const *block) noexcept
+{
+    using word_type = typename Traits::word_type;
+    constexpr std::size_t wordSize = sizeof(word_type);
+
+    std::array<word_type, 16> m{};
+    for (std::size_t i = 0; i < m.size(); ++i)
+    {
+        for (std::size_t j = 0; j < wordSize; ++j)
+        {
+            m[i] |= static_cast<word_type>(
+                    static_cast<word_type>(block[(i * wordSize) + j])
+                    << (8U * j));
+        }
+    }
+
+    std::array<word_type, 16> v{};
+    for (std::size_t i = 0; i < 8U; ++i)
+    {
+        v[i] = state.h[i];
+        v[i + 8U] = Traits::iv[i];
+    }
+    v[12] ^= state.t[0];
+    v[13] ^= state.t[1];
+    v[14] ^= state.f[0];
+    v[15] ^= state.f[1];
+
+    for (unsigned r = 0; r < Traits::rounds; ++r)
+    {
+        auto const &s = blake2_sigma[r % blake2_sigma.size()];
+        blake2_mix<Traits>(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+        blake2_mix<Traits>(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+        blake2_mix<Traits>(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+        blake2_mix<Traits>(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+        blake2_mix<Traits>(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+        blake2_mix<Traits>(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+        blake2_mix<Traits>(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+        blake2_mix<Traits>(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+
+    for (std::size_t i = 0; i < 8U; ++i)
+    {
+        state.h[i] ^= v[i] ^ v[i + 8U];
+    }
+}
+
+template <typename Traits>
+constexpr void blake2_increment_counter(typename Traits::state_type &state,
+                                        std::size_t inc) noexcept
+{
+    using word_type = typename Traits::word_type;
+    state.t[0] += static_cast<word_type>(inc);
+    state.t[1] += static_cast<word_type>(state.t[0] < inc ? 1U : 0U);
+}
+
+template <typename Traits, typename Byte>
+constexpr void blake2_update_constexpr(typename Traits::state_type &state,
+                                       Byte const *in,
+                                       std::size_t inlen) noexcept
+{
+    constexpr std::size_t blockSize = Traits::block_size;
+    if (inlen == 0U)
+    {
+        return;
+    }
+    std::size_t const left = state.buflen;
+    std::size_t const fill = blockSize - left;
+    if (inlen > fill)
+    {
+        state.buflen = 0U;
+        for (std::size_t i = 0; i < fill; ++i)
+        {
+            state.buf[left + i] = static_cast<std::uint8_t>(in[i]);
+        }
+        blake2_increment_counter<Traits>(state, blockSize);
+        blake2_compress<Traits>(state, state.buf);
+        in += fill;
+        inlen -= fill;
+        while (inlen > blockSize)
+        {
+            std::array<std::uint8_t, blockSize> block{};
+            for (std::size_t i = 0; i < blockSize; ++i)
+            {
+                block[i] = static_cast<std::uint8_t>(in[i]);
+            }
+            blake2_increment_counter<Traits>(state, blockSize);
+            blake2_compress<Traits>(state, block.data());
+            in += blockSize;
+            inlen -= blockSize;
+        }
+    }
+    for (std::size_t i = 0; i < inlen; ++i)
+    {
+        state.buf[state.buflen + i] = static_cast<std::uint8_t>(in[i]);
+    }
+    state.buflen += inlen;
+}
+
+template <typename Traits>
+constexpr void blake2_final_constexpr(typename Traits::state_type &state,
+                                      std::byte *out) noexcept
+{
+    using word_type = typename Traits::word_type;
+    constexpr std::size_t wordSize = sizeof(word_type);
+    if (state.f[0] != 0U)
+    {
+        return;
+    }
+    blake2_increment_counter<Traits>(state, state.buflen);
+    state.f[0] = ~word_type{};
+    for (std::size_t i = state.buflen; i < Traits::block_size; ++i)
+    {
+        state.buf[i] = 0U;
+    }
+    blake2_compress<Traits>(state, state.buf);
+
+    for (std::size_t i = 0; i < state.outlen; ++i)
+    {
+        out[i] = static_cast<std::byte>(state.h[i / wordSize]
+                                        >> (8U * (i % wordSize)));
+    }
+}
+
+// Sequential BLAKE2 hashing with a digest size fixed at compile time. All
+// parameters are validated by the type system, i.e. the streaming functions
+// can't fail and go straight to the dispatched implementation. During constant
+// evaluation the portable implementation above is used instead, which yields
+// identical digests.
+template <typename Traits, std::size_t DigestSize>
+    requires(DigestSize >= 1U && DigestSize <= Traits::max_digest_size)
+class basic_blake2
+{
+    typename Traits::state_type mState;
+
+public:
+    static constexpr std::size_t digest_size = DigestSize;
+    static constexpr std::size_t block_size = Traits::block_size;
+    static constexpr std::size_t max_key_size = Traits::max_key_size;
+
+    using digest_type = std::array<std::byte, digest_size>;
+
+    constexpr basic_blake2() noexcept
+    {
+        init(0U);
+        if (std::is_constant_evaluated())
+        {
+            clear_buffer();
+        }
+    }
+
+    template <std::size_t KeySize>
+        requires(KeySize >= 1U && KeySize <= max_key_size)
+    constexpr explicit basic_blake2(
+            std::span<std::byte const, KeySize> key) noexcept
+    {
+        if (!std::is_constant_evaluated())
+        {
+            Traits::init_key(&mState, digest_size, key.data(), key.size());
+            return;
+        }
+        init(KeySize);
+        clear_buffer();
+        blake2_update_constexpr<Traits>(mState, key.data(), key.size());
+        mState.buflen = block_size;
+    }
+
+    constexpr void update(std::span<std::byte const> data) noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            blake2_update_constexpr<Traits>(mState, data.data(), data.size());
+            return;
+        }
+        Traits::update(&mState, data.data(), data.size());
+    }
+    // std::as_bytes() can't be used during constant evaluation
+    constexpr void update(std::string_view data) noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            blake2_update_constexpr<Traits>(mState, data.data(), data.size());
+            return;
+        }
+        Traits::update(&mState, data.data(), data.size());
+    }
+
+    // may only be called once
+    constexpr void finalize(std::span<std::byte, digest_size> out) noexcept
+    {
+        if (std::is_constant_evaluated())
+        {
+            blake2_final_constexpr<Traits>(mState, out.data());
+            return;
+        }
+        Traits::final(&mState, out.data(), out.size());
+    }
+    [[nodiscard]] constexpr auto finalize() noexcept -> digest_type
+    {
+        digest_type digest{};
+        finalize(digest);
+        return digest;
+    }
+
+    [[nodiscard]] static constexpr auto
+    hash(std::span<std::byte const> data) noexcept -> digest_type
+    {
+        basic_blake2 hasher;
+        hasher.update(data);
+        return hasher.finalize();
+    }
+    [[nodiscard]] static constexpr auto hash(std::string_view data) noexcept
+            -> digest_type
+    {
+        basic_blake2 hasher;
+        hasher.update(data);
+        return hasher.finalize();
+    }
+
+    using child_type = std::span<std::byte const, DPLX_BLAKE2_CHILDBYTES>;
+
+    // computes a Merkle tree node, i.e. the hash of both children concatenated
+    [[nodiscard]] static constexpr auto
+    hash_pair(child_type left, child_type right) noexcept -> digest_type
+    {
+        if (std::is_constant_evaluated())
+        {
+            basic_blake2 hasher;
+            hasher.update(left);
+            hasher.update(right);
+            return hasher.finalize();
+        }
+        digest_type digest;
+        Traits::hash_pair(digest.data(), digest.size(), left.data(),
+                          right.data());
+        return digest;
+    }
+
+private:
+    constexpr void init(std::size_t keySize) noexcept
+    {
+        // the parameter block of a sequential hash without salt and
+        // personalization only differs from zero in its first word
+        for (std::size_t i = 0; i < Traits::iv.size(); ++i)
+        {
+            mState.h[i] = Traits::iv[i];
+        }
+        using word_type = typename Traits::word_type;
+        mState.h[0] ^= static_cast<word_type>(0x0101'0000U ^ (keySize << 8U)
+                                              ^ digest_size);
+        mState.t[0] = mState.t[1] = 0U;
+        mState.f[0] = mState.f[1] = 0U;
+        mState.buflen = 0U;
+        mState.outlen = digest_size;
+        mState.last_node = 0U;
+    }
+    // the buffer is fully written before it is compressed, but constant
+    // evaluation requires every member to be initialized
+    constexpr void clear_buffer() noexcept
+    {
+        for (auto &b : mState.buf)
+        {
+            b = 0U;
+        }
+    }
+};
+
+} // namespace detail
+
+template <std::size_t DigestSize = DPLX_BLAKE2S_OUTBYTES>
+using blake2s = detail::basic_blake2<detail::blake2s_traits, DigestSize>;
+
+template <std::size_t DigestSize = DPLX_BLAKE2B_OUTBYTES>
+using blake2b = detail::basic_blake2<detail::blake2b_traits, DigestSize>;
+
+// A keyed BLAKE2s hash function object for unordered containers whose keys are
+// controlled by an adversary. The hash value is the BLAKE2s MAC of the input
+// with a digest size of sizeof(std::size_t) read as a little endian integer.
+//
+// The state after compressing the key block is computed once by the
+// constructor, i.e. inputs of up to one block are hashed with a single
+// compression. There is no default constructor, because a hasher with a fixed
+// key doesn't protect against hash flooding.
+class blake2s_hasher
+{
+    using value_bytes = std::array<std::uint8_t, sizeof(std::size_t)>;
+
+    dplx_blake2s_compact_state mKeyed;
+    std::size_t mEmpty;
+
+public:
+    using is_transparent = void;
+
+    static constexpr std::size_t max_key_size = DPLX_BLAKE2S_KEYBYTES;
+
+    template <std::size_t KeySize>
+        requires(KeySize >= 1U && KeySize <= max_key_size)
+    explicit blake2s_hasher(std::span<std::byte const, KeySize> key) noexcept
+    {
+        dplx_blake2s_prepared_key prepared;
+        (void)dplx_blake2s_prepare_key(&prepared, sizeof(std::size_t),
+                                       key.data(), key.size());
+
+        // the key block has been compressed, the message continues after it
+        for (std::size_t i = 0; i < 8U; ++i)
+        {
+            mKeyed.h[i] = prepared.h[i];
+        }
+        mKeyed.t[0] = DPLX_BLAKE2S_BLOCKBYTES;
+        mKeyed.t[1] = 0U;
+        mKeyed.outlen = sizeof(std::size_t);
+        mKeyed.last_node = 0U;
+        mKeyed.last_block = 0U;
+
+        // an empty message ends with the key block which therefore can't be
+        // handled by the compact state
+        value_bytes empty{};
+        (void)dplx_blake2s_mac(&prepared, empty.data(), empty.size(), nullptr,
+                               0U);
+        mEmpty = load(empty);
+
+        // the prepared key still contains the key block
+        auto *const bytes = reinterpret_cast<unsigned char volatile *>(
+                &prepared);
+        for (std::size_t i = 0; i < sizeof(prepared); ++i)
+        {
+            bytes[i] = 0U;
+        }
+    }
+
+    [[nodiscard]] auto
+    operator()(std::span<std::byte const> data) const noexcept -> std::size_t
+    {
+        return hash(data.data(), data.size());
+    }
+    [[nodiscard]] auto operator()(std::string_view data) const noexcept
+            -> std::size_t
+    {
+        return hash(data.data(), data.size());
+    }
+
+private:
+    [[nodiscard]] auto hash(void const *data, std::size_t size) const noexcept
+            -> std::size_t
+    {
+        if (size == 0U)
+        {
+            return mEmpty;
+        }
+
+        dplx_blake2s_compact_state state = mKeyed;
+        auto const *in = static_cast<std::byte const *>(data);
+        if (size > DPLX_BLAKE2S_BLOCKBYTES)
+        {
+            // all but the last (possibly partial) block
+            std::size_t const head = (size - 1U) / DPLX_BLAKE2S_BLOCKBYTES
+                                     * DPLX_BLAKE2S_BLOCKBYTES;
+            (void)dplx_blake2s_compact_update(&state, in, head);
+            in += head;
+            size -= head;
+        }
+
+        value_bytes value{};
+        (void)dplx_blake2s_compact_final(&state, in, size, value.data(),
+                                         value.size());
+        return load(value);
+    }
+
+    [[nodiscard]] static auto load(value_bytes const &bytes) noexcept
+            -> std::size_t
+    {
+        std::size_t value = 0U;
+        for (std::size_t i = 0; i < bytes.size(); ++i)
+        {
+            value |= static_cast<std::size_t>(bytes[i]) << (8U * i);
+        }
+        return value;
+    }
+};
+
+} // namespace dplx
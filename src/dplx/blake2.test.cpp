@@ -7,8 +7,13 @@
 
 #include "dplx/blake2.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
 
 #include <blake2.h>
 #include <catch2/catch_test_macros.hpp>
@@ -20,6 +25,7 @@
 #include "blob_matcher.hpp"
 #include "impl_id_generator.hpp"
 #include "kat_json_generator.hpp"
+#include "test_utils.hpp"
 
 namespace blake2_tests
 {
@@ -77,10 +83,185 @@ TEST_CASE("dplx_blake2s_*() should correctly compute the official testvectors")
     CHECK_BLOB_EQ(out, ka.out);
 }
 
-TEST_CASE("dplx_blake2xs() should correctly compute the official testvectors")
+TEST_CASE("dplx_blake2s_updatev() should match dplx_blake2s() for fragmented "
+          "input")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const fragmentSize = GENERATE(1U, 5U, 64U, 200U);
+    INFO("fragment size: " << fragmentSize);
+
+    auto const in = make_test_input(1000U);
+
+    // interleaves the fragments with empty ones
+    std::vector<dplx_blake2_iovec> iov;
+    for (std::size_t offset = 0; offset < in.size(); offset += fragmentSize)
+    {
+        iov.push_back({in.data() + offset,
+                       std::min(fragmentSize, in.size() - offset)});
+        iov.push_back({nullptr, 0U});
+    }
+
+    dplx_blake2s_state state{};
+    REQUIRE(dplx_blake2s_init(&state, DPLX_BLAKE2S_OUTBYTES) == 0);
+    REQUIRE(dplx_blake2s_updatev(&state, iov.data(), iov.size()) == 0);
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> out{};
+    REQUIRE(dplx_blake2s_final(&state, out.data(), out.size()) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2s(expected.data(), expected.size(), in.data(),
+                         in.size(), nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+}
+
+TEST_CASE("dplx_blake2s() should match dplx_blake2s_*() for single block "
+          "messages")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const outlen = GENERATE(1U, 16U, 20U, 31U, 32U);
+    std::size_t const inlen = GENERATE(0U, 1U, 63U, 64U);
+    INFO("outlen: " << outlen << ", inlen: " << inlen);
+
+    auto const in = make_test_input(inlen);
+
+    dplx_blake2s_state state{};
+    REQUIRE(dplx_blake2s_init(&state, outlen) == 0);
+    REQUIRE(dplx_blake2s_update(&state, in.data(), in.size()) == 0);
+    std::vector<std::uint8_t> expected(outlen);
+    REQUIRE(dplx_blake2s_final(&state, expected.data(), expected.size())
+            == 0);
+
+    std::vector<std::uint8_t> out(outlen);
+    REQUIRE(dplx_blake2s(out.data(), out.size(), in.data(), in.size(),
+                         nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+}
+
+TEST_CASE("dplx_blake2s_final_with_data() should match dplx_blake2s()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const headSize = GENERATE(0U, 1U, 64U);
+    std::size_t const tailSize = GENERATE(0U, 1U, 63U, 64U, 65U, 128U);
+    INFO("head size: " << headSize << ", tail size: " << tailSize);
+
+    auto const in = make_test_input(headSize + tailSize);
+
+    dplx_blake2s_state state{};
+    REQUIRE(dplx_blake2s_init(&state, DPLX_BLAKE2S_OUTBYTES) == 0);
+    REQUIRE(dplx_blake2s_update(&state, in.data(), headSize) == 0);
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> out{};
+    REQUIRE(dplx_blake2s_final_with_data(&state, in.data() + headSize,
+                                         tailSize, out.data(), out.size())
+            == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2s(expected.data(), expected.size(), in.data(),
+                         in.size(), nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+
+    CHECK(dplx_blake2s_final_with_data(&state, nullptr, 0U, out.data(),
+                                       out.size())
+          == -1);
+}
+
+TEST_CASE("dplx_blake2s_compact_*() should match dplx_blake2s()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const inlen = GENERATE(0U, 1U, 64U, 65U, 128U, 1000U);
+    INFO("inlen: " << inlen);
+
+    auto const in = make_test_input(inlen);
+
+    // the last block, whether complete or not, is passed to final
+    std::size_t const lastSize
+            = inlen == 0U ? 0U : (inlen - 1U) % DPLX_BLAKE2S_BLOCKBYTES + 1U;
+    std::size_t const headSize = inlen - lastSize;
+
+    dplx_blake2s_compact_state state{};
+    REQUIRE(dplx_blake2s_compact_init(&state, DPLX_BLAKE2S_OUTBYTES) == 0);
+    CHECK(dplx_blake2s_compact_update(&state, in.data(), 1U) == -1);
+    REQUIRE(dplx_blake2s_compact_update(&state, in.data(), headSize) == 0);
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> out{};
+    if (headSize > 0U)
+    {
+        CHECK(dplx_blake2s_compact_final(&state, nullptr, 0U, out.data(),
+                                         out.size())
+              == -1);
+    }
+    REQUIRE(dplx_blake2s_compact_final(&state, in.data() + headSize, lastSize,
+                                       out.data(), out.size())
+            == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2s(expected.data(), expected.size(), in.data(),
+                         in.size(), nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+}
+
+TEST_CASE("dplx_blake2s_state_import() should resume an exported state")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const splitAt = GENERATE(0U, 1U, 64U, 64U + 1U, 500U);
+    INFO("split at: " << splitAt);
+
+    auto const in = make_test_input(1000U);
+
+    dplx_blake2s_state state{};
+    REQUIRE(dplx_blake2s_init(&state, DPLX_BLAKE2S_OUTBYTES) == 0);
+    REQUIRE(dplx_blake2s_update(&state, in.data(), splitAt) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2S_STATEBYTES> serialized{};
+    REQUIRE(dplx_blake2s_state_export(&state, serialized.data()) == 0);
+    CHECK(dplx_blake2s_state_import(nullptr, serialized.data()) == -1);
+
+    dplx_blake2s_state resumed{};
+    REQUIRE(dplx_blake2s_state_import(&resumed, serialized.data()) == 0);
+    REQUIRE(dplx_blake2s_update(&resumed, in.data() + splitAt,
+                                in.size() - splitAt)
+            == 0);
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> out{};
+    REQUIRE(dplx_blake2s_final(&resumed, out.data(), out.size()) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2s(expected.data(), expected.size(), in.data(),
+                         in.size(), nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+
+    // states of other algorithms and format versions are rejected
+    dplx_blake2b_state other{};
+    CHECK(dplx_blake2b_state_import(&other, serialized.data()) == -1);
+    serialized[0] = DPLX_BLAKE2_STATE_FORMAT_VERSION + 1U;
+    CHECK(dplx_blake2s_state_import(&resumed, serialized.data()) == -1);
+}
+
+TEST_CASE("dplx_blake2sp() should correctly compute the official testvectors")
 {
     b2_known_answer_dto ka
-            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2xs"));
+            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2sp"));
 
     INFO(ka);
 
@@ -89,19 +270,19 @@ TEST_CASE("dplx_blake2xs() should correctly compute the official testvectors")
     INFO("impl id: " << implId);
     REQUIRE(dplx_blake2_use_implementation(implId) == 0);
 
-    std::vector<std::uint8_t> out(ka.out.size());
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> out{};
 
-    REQUIRE(dplx_blake2xs(out.data(), out.size(), ka.in.data(), ka.in.size(),
+    REQUIRE(dplx_blake2sp(out.data(), out.size(), ka.in.data(), ka.in.size(),
                           ka.key.data(), ka.key.size())
             == 0);
 
     CHECK_BLOB_EQ(out, ka.out);
 }
 
-TEST_CASE("dplx_blake2xs_*() should correctly compute the official testvectors")
+TEST_CASE("dplx_blake2sp_*() should correctly compute the official testvectors")
 {
     b2_known_answer_dto ka
-            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2xs"));
+            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2sp"));
 
     INFO(ka);
 
@@ -110,83 +291,260 @@ TEST_CASE("dplx_blake2xs_*() should correctly compute the official testvectors")
     INFO("impl id: " << implId);
     REQUIRE(dplx_blake2_use_implementation(implId) == 0);
 
-    dplx_blake2xs_state ctx{};
+    dplx_blake2sp_state ctx{};
     if (ka.key.size() > 0)
     {
-        REQUIRE(dplx_blake2xs_init_key(&ctx, ka.out.size(), ka.key.data(),
+        REQUIRE(dplx_blake2sp_init_key(&ctx, ka.out.size(), ka.key.data(),
                                        ka.key.size())
                 == 0);
     }
     else
     {
-        REQUIRE(dplx_blake2xs_init(&ctx, ka.out.size()) == 0);
+        REQUIRE(dplx_blake2sp_init(&ctx, ka.out.size()) == 0);
     }
 
-    REQUIRE(dplx_blake2xs_update(&ctx, ka.in.data(), ka.in.size()) == 0);
+    REQUIRE(dplx_blake2sp_update(&ctx, ka.in.data(), ka.in.size()) == 0);
 
-    std::vector<std::uint8_t> out(ka.out.size());
-    REQUIRE(dplx_blake2xs_final(&ctx, out.data(), out.size()) == 0);
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> out{};
+    REQUIRE(dplx_blake2sp_final(&ctx, out.data(), out.size()) == 0);
 
     CHECK_BLOB_EQ(out, ka.out);
 }
 
-TEST_CASE("dplx_blake2b() should correctly compute the official testvectors")
+TEST_CASE("dplx_blake2s_many() should correctly compute the official "
+          "testvectors")
 {
-    b2_known_answer_dto ka
-            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2b"));
+    std::vector<b2_known_answer_dto> kas;
+    auto katGen = load_kat_from_json("blake2-kat.json", "blake2s");
+    do
+    {
+        kas.push_back(katGen.get());
+    }
+    while (katGen.next());
 
-    INFO(ka);
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::vector<std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES>> outs(
+            kas.size());
+    std::vector<dplx_blake2s_job> jobs;
+    for (std::size_t i = 0; i < kas.size(); ++i)
+    {
+        jobs.push_back({outs[i].data(), outs[i].size(), kas[i].in.data(),
+                        kas[i].in.size(), kas[i].key.data(),
+                        kas[i].key.size()});
+    }
+
+    REQUIRE(dplx_blake2s_many(jobs.data(), jobs.size()) == 0);
+
+    for (std::size_t i = 0; i < kas.size(); ++i)
+    {
+        INFO(kas[i]);
+        CHECK_BLOB_EQ(outs[i], kas[i].out);
+    }
+}
 
+TEST_CASE("dplx_blake2s_many() should match dplx_blake2s() for mixed jobs")
+{
     dplx_blake2_implementation_id implId
             = GENERATE(available_blake2_impl_ids());
     INFO("impl id: " << implId);
     REQUIRE(dplx_blake2_use_implementation(implId) == 0);
 
-    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+    auto const in = make_test_input(519U);
+    std::array<std::uint8_t, DPLX_BLAKE2S_KEYBYTES> key{};
+    for (std::size_t i = 0; i < key.size(); ++i)
+    {
+        key[i] = static_cast<std::uint8_t>(i);
+    }
 
-    REQUIRE(dplx_blake2b(out.data(), out.size(), ka.in.data(), ka.in.size(),
-                         ka.key.data(), ka.key.size())
-            == 0);
+    // lengths spread around the block boundaries and in descending order so
+    // that lanes drain at different times
+    constexpr std::size_t numJobs = 67U;
+    std::vector<std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES>> outs(numJobs);
+    std::vector<dplx_blake2s_job> jobs;
+    for (std::size_t i = 0; i < numJobs; ++i)
+    {
+        std::size_t const inlen = (in.size() - i * 7U) % in.size();
+        std::size_t const keylen = i % 3U == 0U ? 0U : i % key.size() + 1U;
+        std::size_t const outlen = i % DPLX_BLAKE2S_OUTBYTES + 1U;
+        jobs.push_back({outs[i].data(), outlen, in.data(), inlen,
+                        keylen > 0U ? key.data() : nullptr, keylen});
+    }
 
-    CHECK_BLOB_EQ(out, ka.out);
+    REQUIRE(dplx_blake2s_many(jobs.data(), jobs.size()) == 0);
+
+    for (auto const &job : jobs)
+    {
+        INFO("inlen: " << job.inlen << " keylen: " << job.keylen
+                       << " outlen: " << job.outlen);
+        std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> expected{};
+        REQUIRE(dplx_blake2s(expected.data(), job.outlen, job.in, job.inlen,
+                             job.key, job.keylen)
+                == 0);
+        CHECK_BLOB_EQ(std::span(static_cast<std::uint8_t const *>(job.out),
+                                job.outlen),
+                      std::span(expected).first(job.outlen));
+    }
 }
 
-TEST_CASE("dplx_blake2b_*() should correctly compute the official testvectors")
+TEST_CASE("dplx_blake2s prepared keys should match keyed dplx_blake2s()")
 {
-    b2_known_answer_dto ka
-            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2b"));
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
 
-    INFO(ka);
+    std::size_t const inlen = GENERATE(0U, 1U, 64U, 64U + 1U, 1000U);
+    INFO("inlen: " << inlen);
+
+    auto const in = make_test_input(inlen);
+    std::array<std::uint8_t, DPLX_BLAKE2S_KEYBYTES> key{};
+    for (std::size_t i = 0; i < key.size(); ++i)
+    {
+        key[i] = static_cast<std::uint8_t>(i);
+    }
+
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2s(expected.data(), expected.size(), in.data(),
+                         in.size(), key.data(), key.size())
+            == 0);
+
+    dplx_blake2s_prepared_key prepared{};
+    REQUIRE(dplx_blake2s_prepare_key(&prepared, DPLX_BLAKE2S_OUTBYTES,
+                                     key.data(), key.size())
+            == 0);
+
+    SECTION("with dplx_blake2s_mac()")
+    {
+        std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> out{};
+        REQUIRE(dplx_blake2s_mac(&prepared, out.data(), out.size(), in.data(),
+                                 in.size())
+                == 0);
+        CHECK_BLOB_EQ(out, expected);
+    }
+    SECTION("with dplx_blake2s_init_prepared()")
+    {
+        dplx_blake2s_state state{};
+        REQUIRE(dplx_blake2s_init_prepared(&state, &prepared) == 0);
+        REQUIRE(dplx_blake2s_update(&state, in.data(), in.size()) == 0);
+        std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> out{};
+        REQUIRE(dplx_blake2s_final(&state, out.data(), out.size()) == 0);
+        CHECK_BLOB_EQ(out, expected);
+    }
+    SECTION("with dplx_blake2s_mac_many()")
+    {
+        std::vector<std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES>> outs(11U);
+        std::vector<dplx_blake2s_job> jobs;
+        for (auto &out : outs)
+        {
+            jobs.push_back({out.data(), out.size(), in.data(), in.size(),
+                            nullptr, 0U});
+        }
+        REQUIRE(dplx_blake2s_mac_many(&prepared, jobs.data(), jobs.size())
+                == 0);
+        for (auto const &out : outs)
+        {
+            CHECK_BLOB_EQ(out, expected);
+        }
+    }
+}
 
+TEST_CASE("dplx_blake2s_hash_pairs() should match dplx_blake2s() for each "
+          "pair")
+{
     dplx_blake2_implementation_id implId
             = GENERATE(available_blake2_impl_ids());
     INFO("impl id: " << implId);
     REQUIRE(dplx_blake2_use_implementation(implId) == 0);
 
-    dplx_blake2b_state ctx{};
-    if (ka.key.size() > 0)
+    std::size_t const outlen = GENERATE(20U, 32U);
+    std::size_t const n = GENERATE(1U, 2U, 8U, 8U + 1U, 17U);
+    INFO("outlen: " << outlen << ", n: " << n);
+
+    constexpr std::size_t pairSize = 2U * DPLX_BLAKE2_CHILDBYTES;
+    auto children = make_test_input(n * pairSize);
+
+    std::vector<std::uint8_t> expected(n * outlen);
+    for (std::size_t i = 0; i < n; ++i)
     {
-        REQUIRE(dplx_blake2b_init_key(&ctx, ka.out.size(), ka.key.data(),
-                                      ka.key.size())
+        REQUIRE(dplx_blake2s(expected.data() + (i * outlen), outlen,
+                             children.data() + (i * pairSize), pairSize,
+                             nullptr, 0U)
                 == 0);
     }
-    else
+
+    SECTION("with dplx_blake2s_hash_pair()")
     {
-        REQUIRE(dplx_blake2b_init(&ctx, ka.out.size()) == 0);
+        std::vector<std::uint8_t> out(n * outlen);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::uint8_t const *pair = children.data() + (i * pairSize);
+            REQUIRE(dplx_blake2s_hash_pair(out.data() + (i * outlen), outlen,
+                                           pair,
+                                           pair + DPLX_BLAKE2_CHILDBYTES)
+                    == 0);
+        }
+        CHECK_BLOB_EQ(out, expected);
+    }
+    SECTION("with dplx_blake2s_hash_pairs()")
+    {
+        std::vector<std::uint8_t> out(n * outlen);
+        REQUIRE(dplx_blake2s_hash_pairs(out.data(), outlen, children.data(),
+                                        n)
+                == 0);
+        CHECK_BLOB_EQ(out, expected);
+    }
+    SECTION("with dplx_blake2s_hash_pairs() in place")
+    {
+        REQUIRE(dplx_blake2s_hash_pairs(children.data(), outlen,
+                                        children.data(), n)
+                == 0);
+        children.resize(n * outlen);
+        CHECK_BLOB_EQ(children, expected);
     }
+}
 
-    REQUIRE(dplx_blake2b_update(&ctx, ka.in.data(), ka.in.size()) == 0);
+TEST_CASE("dplx_blake2s_compress() should match dplx_blake2s() for a "
+          "single block")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
 
-    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
-    REQUIRE(dplx_blake2b_final(&ctx, out.data(), out.size()) == 0);
+    std::size_t const inlen = GENERATE(0U, 1U, 63U, 64U);
+    INFO("inlen: " << inlen);
 
-    CHECK_BLOB_EQ(out, ka.out);
+    std::array<std::uint8_t, DPLX_BLAKE2S_BLOCKBYTES> block{};
+    fill_test_input(std::span(block).first(inlen));
+
+    dplx_blake2s_state state{};
+    REQUIRE(dplx_blake2s_init(&state, DPLX_BLAKE2S_OUTBYTES) == 0);
+    std::uint32_t const t[2] = {static_cast<std::uint32_t>(inlen), 0U};
+    std::uint32_t const f[2] = {~std::uint32_t{}, 0U};
+    REQUIRE(dplx_blake2s_compress(state.h, block.data(), t, f) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> out{};
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        out[i] = static_cast<std::uint8_t>(state.h[i / sizeof(state.h[0])]
+                                           >> (8U * (i % sizeof(state.h[0]))));
+    }
+
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2s(expected.data(), expected.size(), block.data(), inlen,
+                         nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
 }
 
-TEST_CASE("dplx_blake2xb() should correctly compute the official testvectors")
+TEST_CASE("dplx_blake2xs() should correctly compute the official testvectors")
 {
     b2_known_answer_dto ka
-            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2xb"));
+            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2xs"));
 
     INFO(ka);
 
@@ -197,17 +555,17 @@ TEST_CASE("dplx_blake2xb() should correctly compute the official testvectors")
 
     std::vector<std::uint8_t> out(ka.out.size());
 
-    REQUIRE(dplx_blake2xb(out.data(), out.size(), ka.in.data(), ka.in.size(),
+    REQUIRE(dplx_blake2xs(out.data(), out.size(), ka.in.data(), ka.in.size(),
                           ka.key.data(), ka.key.size())
             == 0);
 
     CHECK_BLOB_EQ(out, ka.out);
 }
 
-TEST_CASE("dplx_blake2xb_*() should correctly compute the official testvectors")
+TEST_CASE("dplx_blake2xs_*() should correctly compute the official testvectors")
 {
     b2_known_answer_dto ka
-            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2xb"));
+            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2xs"));
 
     INFO(ka);
 
@@ -216,24 +574,1273 @@ TEST_CASE("dplx_blake2xb_*() should correctly compute the official testvectors")
     INFO("impl id: " << implId);
     REQUIRE(dplx_blake2_use_implementation(implId) == 0);
 
-    dplx_blake2xb_state ctx{};
+    dplx_blake2xs_state ctx{};
     if (ka.key.size() > 0)
     {
-        REQUIRE(dplx_blake2xb_init_key(&ctx, ka.out.size(), ka.key.data(),
+        REQUIRE(dplx_blake2xs_init_key(&ctx, ka.out.size(), ka.key.data(),
                                        ka.key.size())
                 == 0);
     }
     else
     {
-        REQUIRE(dplx_blake2xb_init(&ctx, ka.out.size()) == 0);
+        REQUIRE(dplx_blake2xs_init(&ctx, ka.out.size()) == 0);
     }
 
-    REQUIRE(dplx_blake2xb_update(&ctx, ka.in.data(), ka.in.size()) == 0);
+    REQUIRE(dplx_blake2xs_update(&ctx, ka.in.data(), ka.in.size()) == 0);
 
     std::vector<std::uint8_t> out(ka.out.size());
-    REQUIRE(dplx_blake2xb_final(&ctx, out.data(), out.size()) == 0);
+    REQUIRE(dplx_blake2xs_final(&ctx, out.data(), out.size()) == 0);
 
     CHECK_BLOB_EQ(out, ka.out);
 }
 
+TEST_CASE("dplx_blake2xs() should match the BLAKE2XS definition for long "
+          "outputs")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const outlen = GENERATE(255U, 256U, 257U, 1000U, 4097U);
+    INFO("outlen: " << outlen);
+
+    std::array<std::uint8_t, 3> const in{'a', 'b', 'c'};
+    std::vector<std::uint8_t> out(outlen);
+    REQUIRE(dplx_blake2xs(out.data(), out.size(), in.data(), in.size(),
+                          nullptr, 0U)
+            == 0);
+
+    // the output is the concatenation of the hashes of the root hash with
+    // node_offset set to the block index
+    dplx_blake2s_param param{};
+    param.digest_length = DPLX_BLAKE2S_OUTBYTES;
+    param.fanout = 1U;
+    param.depth = 1U;
+    param.xof_length = static_cast<std::uint16_t>(outlen);
+    dplx_blake2s_state state{};
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> root{};
+    REQUIRE(dplx_blake2s_init_param(&state, &param) == 0);
+    REQUIRE(dplx_blake2s_update(&state, in.data(), in.size()) == 0);
+    REQUIRE(dplx_blake2s_final(&state, root.data(), root.size()) == 0);
+
+    std::vector<std::uint8_t> expected(outlen);
+    for (std::size_t offset = 0; offset < outlen;
+         offset += DPLX_BLAKE2S_OUTBYTES)
+    {
+        std::size_t const blockSize
+                = std::min<std::size_t>(outlen - offset, DPLX_BLAKE2S_OUTBYTES);
+        param.digest_length = static_cast<std::uint8_t>(blockSize);
+        param.fanout = 0U;
+        param.depth = 0U;
+        param.leaf_length = DPLX_BLAKE2S_OUTBYTES;
+        param.node_offset
+                = static_cast<std::uint32_t>(offset / DPLX_BLAKE2S_OUTBYTES);
+        param.inner_length = DPLX_BLAKE2S_OUTBYTES;
+        REQUIRE(dplx_blake2s_init_param(&state, &param) == 0);
+        REQUIRE(dplx_blake2s_update(&state, root.data(), root.size()) == 0);
+        REQUIRE(dplx_blake2s_final(&state, expected.data() + offset, blockSize)
+                == 0);
+    }
+    CHECK_BLOB_EQ(out, expected);
+}
+
+TEST_CASE("dplx_blake2xs_squeeze_at() should match dplx_blake2xs_final()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    constexpr std::size_t outlen = 1000U;
+    std::size_t const offset = GENERATE(0U, 1U, 31U, 32U, 300U);
+    std::size_t const size = GENERATE(0U, 1U, 17U, 32U, 291U);
+    INFO("offset: " << offset << ", size: " << size);
+
+    std::array<std::uint8_t, 3> const in{'a', 'b', 'c'};
+    dplx_blake2xs_state state{};
+    REQUIRE(dplx_blake2xs_init(&state, outlen) == 0);
+    REQUIRE(dplx_blake2xs_update(&state, in.data(), in.size()) == 0);
+    dplx_blake2xs_state seekable = state;
+
+    std::vector<std::uint8_t> expected(outlen);
+    REQUIRE(dplx_blake2xs_final(&state, expected.data(), expected.size()) == 0);
+    expected.erase(expected.begin(),
+                   expected.begin() + static_cast<std::ptrdiff_t>(offset));
+    expected.resize(size);
+
+    std::vector<std::uint8_t> out(size);
+    REQUIRE(dplx_blake2xs_squeeze_at(&seekable, offset, out.data(), out.size())
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+
+    // the root hash is finalized once, repeated reads yield the same output
+    REQUIRE(dplx_blake2xs_squeeze_at(&seekable, offset, out.data(), out.size())
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+
+    CHECK(dplx_blake2xs_squeeze_at(&seekable, outlen - size + 1U, out.data(),
+                                    out.size())
+          == -1);
+}
+
+TEST_CASE("dplx_blake2xs_squeeze() should stream the output of "
+          "dplx_blake2xs_final()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    constexpr std::size_t outlen = 1000U;
+    std::size_t const chunkSize = GENERATE(1U, 7U, 32U, 300U);
+    INFO("chunk size: " << chunkSize);
+
+    std::array<std::uint8_t, 3> const in{'a', 'b', 'c'};
+    dplx_blake2xs_state state{};
+    REQUIRE(dplx_blake2xs_init(&state, outlen) == 0);
+    REQUIRE(dplx_blake2xs_update(&state, in.data(), in.size()) == 0);
+    dplx_blake2xs_state stream = state;
+
+    std::vector<std::uint8_t> expected(outlen);
+    REQUIRE(dplx_blake2xs_final(&state, expected.data(), expected.size()) == 0);
+
+    std::vector<std::uint8_t> out(outlen);
+    for (std::size_t offset = 0; offset < outlen; offset += chunkSize)
+    {
+        REQUIRE(dplx_blake2xs_squeeze(&stream, out.data() + offset,
+                                      std::min(chunkSize, outlen - offset))
+                == 0);
+    }
+    CHECK_BLOB_EQ(out, expected);
+
+    CHECK(dplx_blake2xs_squeeze(&stream, out.data(), 1U) == -1);
+}
+
+TEST_CASE("dplx_blake2b() should correctly compute the official testvectors")
+{
+    b2_known_answer_dto ka
+            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2b"));
+
+    INFO(ka);
+
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+
+    REQUIRE(dplx_blake2b(out.data(), out.size(), ka.in.data(), ka.in.size(),
+                         ka.key.data(), ka.key.size())
+            == 0);
+
+    CHECK_BLOB_EQ(out, ka.out);
+}
+
+TEST_CASE("dplx_blake2b_*() should correctly compute the official testvectors")
+{
+    b2_known_answer_dto ka
+            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2b"));
+
+    INFO(ka);
+
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    dplx_blake2b_state ctx{};
+    if (ka.key.size() > 0)
+    {
+        REQUIRE(dplx_blake2b_init_key(&ctx, ka.out.size(), ka.key.data(),
+                                      ka.key.size())
+                == 0);
+    }
+    else
+    {
+        REQUIRE(dplx_blake2b_init(&ctx, ka.out.size()) == 0);
+    }
+
+    REQUIRE(dplx_blake2b_update(&ctx, ka.in.data(), ka.in.size()) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+    REQUIRE(dplx_blake2b_final(&ctx, out.data(), out.size()) == 0);
+
+    CHECK_BLOB_EQ(out, ka.out);
+}
+
+TEST_CASE("dplx_blake2b_updatev() should match dplx_blake2b() for fragmented "
+          "input")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const fragmentSize = GENERATE(1U, 5U, 128U, 200U);
+    INFO("fragment size: " << fragmentSize);
+
+    auto const in = make_test_input(1000U);
+
+    // interleaves the fragments with empty ones
+    std::vector<dplx_blake2_iovec> iov;
+    for (std::size_t offset = 0; offset < in.size(); offset += fragmentSize)
+    {
+        iov.push_back({in.data() + offset,
+                       std::min(fragmentSize, in.size() - offset)});
+        iov.push_back({nullptr, 0U});
+    }
+
+    dplx_blake2b_state state{};
+    REQUIRE(dplx_blake2b_init(&state, DPLX_BLAKE2B_OUTBYTES) == 0);
+    REQUIRE(dplx_blake2b_updatev(&state, iov.data(), iov.size()) == 0);
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+    REQUIRE(dplx_blake2b_final(&state, out.data(), out.size()) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2b(expected.data(), expected.size(), in.data(),
+                         in.size(), nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+}
+
+TEST_CASE("dplx_blake2b() should match dplx_blake2b_*() for single block "
+          "messages")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const outlen = GENERATE(1U, 20U, 32U, 63U, 64U);
+    std::size_t const inlen = GENERATE(0U, 1U, 127U, 128U);
+    INFO("outlen: " << outlen << ", inlen: " << inlen);
+
+    auto const in = make_test_input(inlen);
+
+    dplx_blake2b_state state{};
+    REQUIRE(dplx_blake2b_init(&state, outlen) == 0);
+    REQUIRE(dplx_blake2b_update(&state, in.data(), in.size()) == 0);
+    std::vector<std::uint8_t> expected(outlen);
+    REQUIRE(dplx_blake2b_final(&state, expected.data(), expected.size())
+            == 0);
+
+    std::vector<std::uint8_t> out(outlen);
+    REQUIRE(dplx_blake2b(out.data(), out.size(), in.data(), in.size(),
+                         nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+}
+
+TEST_CASE("dplx_blake2b_final_with_data() should match dplx_blake2b()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const headSize = GENERATE(0U, 1U, 128U);
+    std::size_t const tailSize = GENERATE(0U, 1U, 127U, 128U, 129U, 256U);
+    INFO("head size: " << headSize << ", tail size: " << tailSize);
+
+    auto const in = make_test_input(headSize + tailSize);
+
+    dplx_blake2b_state state{};
+    REQUIRE(dplx_blake2b_init(&state, DPLX_BLAKE2B_OUTBYTES) == 0);
+    REQUIRE(dplx_blake2b_update(&state, in.data(), headSize) == 0);
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+    REQUIRE(dplx_blake2b_final_with_data(&state, in.data() + headSize,
+                                         tailSize, out.data(), out.size())
+            == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2b(expected.data(), expected.size(), in.data(),
+                         in.size(), nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+
+    CHECK(dplx_blake2b_final_with_data(&state, nullptr, 0U, out.data(),
+                                       out.size())
+          == -1);
+}
+
+TEST_CASE("dplx_blake2b_compact_*() should match dplx_blake2b()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const inlen = GENERATE(0U, 1U, 128U, 129U, 256U, 1000U);
+    INFO("inlen: " << inlen);
+
+    auto const in = make_test_input(inlen);
+
+    // the last block, whether complete or not, is passed to final
+    std::size_t const lastSize
+            = inlen == 0U ? 0U : (inlen - 1U) % DPLX_BLAKE2B_BLOCKBYTES + 1U;
+    std::size_t const headSize = inlen - lastSize;
+
+    dplx_blake2b_compact_state state{};
+    REQUIRE(dplx_blake2b_compact_init(&state, DPLX_BLAKE2B_OUTBYTES) == 0);
+    CHECK(dplx_blake2b_compact_update(&state, in.data(), 1U) == -1);
+    REQUIRE(dplx_blake2b_compact_update(&state, in.data(), headSize) == 0);
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+    if (headSize > 0U)
+    {
+        CHECK(dplx_blake2b_compact_final(&state, nullptr, 0U, out.data(),
+                                         out.size())
+              == -1);
+    }
+    REQUIRE(dplx_blake2b_compact_final(&state, in.data() + headSize, lastSize,
+                                       out.data(), out.size())
+            == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2b(expected.data(), expected.size(), in.data(),
+                         in.size(), nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+}
+
+TEST_CASE("dplx_blake2b_state_import() should resume an exported state")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const splitAt = GENERATE(0U, 1U, 128U, 128U + 1U, 500U);
+    INFO("split at: " << splitAt);
+
+    auto const in = make_test_input(1000U);
+
+    dplx_blake2b_state state{};
+    REQUIRE(dplx_blake2b_init(&state, DPLX_BLAKE2B_OUTBYTES) == 0);
+    REQUIRE(dplx_blake2b_update(&state, in.data(), splitAt) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_STATEBYTES> serialized{};
+    REQUIRE(dplx_blake2b_state_export(&state, serialized.data()) == 0);
+    CHECK(dplx_blake2b_state_import(nullptr, serialized.data()) == -1);
+
+    dplx_blake2b_state resumed{};
+    REQUIRE(dplx_blake2b_state_import(&resumed, serialized.data()) == 0);
+    REQUIRE(dplx_blake2b_update(&resumed, in.data() + splitAt,
+                                in.size() - splitAt)
+            == 0);
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+    REQUIRE(dplx_blake2b_final(&resumed, out.data(), out.size()) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2b(expected.data(), expected.size(), in.data(),
+                         in.size(), nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+
+    // states of other algorithms and format versions are rejected
+    dplx_blake2s_state other{};
+    CHECK(dplx_blake2s_state_import(&other, serialized.data()) == -1);
+    serialized[0] = DPLX_BLAKE2_STATE_FORMAT_VERSION + 1U;
+    CHECK(dplx_blake2b_state_import(&resumed, serialized.data()) == -1);
+}
+
+TEST_CASE("dplx_blake2bp() should correctly compute the official testvectors")
+{
+    b2_known_answer_dto ka
+            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2bp"));
+
+    INFO(ka);
+
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+
+    REQUIRE(dplx_blake2bp(out.data(), out.size(), ka.in.data(), ka.in.size(),
+                          ka.key.data(), ka.key.size())
+            == 0);
+
+    CHECK_BLOB_EQ(out, ka.out);
+}
+
+TEST_CASE("dplx_blake2bp_*() should correctly compute the official testvectors")
+{
+    b2_known_answer_dto ka
+            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2bp"));
+
+    INFO(ka);
+
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    dplx_blake2bp_state ctx{};
+    if (ka.key.size() > 0)
+    {
+        REQUIRE(dplx_blake2bp_init_key(&ctx, ka.out.size(), ka.key.data(),
+                                       ka.key.size())
+                == 0);
+    }
+    else
+    {
+        REQUIRE(dplx_blake2bp_init(&ctx, ka.out.size()) == 0);
+    }
+
+    REQUIRE(dplx_blake2bp_update(&ctx, ka.in.data(), ka.in.size()) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+    REQUIRE(dplx_blake2bp_final(&ctx, out.data(), out.size()) == 0);
+
+    CHECK_BLOB_EQ(out, ka.out);
+}
+
+TEST_CASE("dplx_blake2b_many() should correctly compute the official "
+          "testvectors")
+{
+    std::vector<b2_known_answer_dto> kas;
+    auto katGen = load_kat_from_json("blake2-kat.json", "blake2b");
+    do
+    {
+        kas.push_back(katGen.get());
+    }
+    while (katGen.next());
+
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::vector<std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES>> outs(
+            kas.size());
+    std::vector<dplx_blake2b_job> jobs;
+    for (std::size_t i = 0; i < kas.size(); ++i)
+    {
+        jobs.push_back({outs[i].data(), outs[i].size(), kas[i].in.data(),
+                        kas[i].in.size(), kas[i].key.data(),
+                        kas[i].key.size()});
+    }
+
+    REQUIRE(dplx_blake2b_many(jobs.data(), jobs.size()) == 0);
+
+    for (std::size_t i = 0; i < kas.size(); ++i)
+    {
+        INFO(kas[i]);
+        CHECK_BLOB_EQ(outs[i], kas[i].out);
+    }
+}
+
+TEST_CASE("dplx_blake2b_many() should match dplx_blake2b() for mixed jobs")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    auto const in = make_test_input(1031U);
+    std::array<std::uint8_t, DPLX_BLAKE2B_KEYBYTES> key{};
+    for (std::size_t i = 0; i < key.size(); ++i)
+    {
+        key[i] = static_cast<std::uint8_t>(i);
+    }
+
+    // lengths spread around the block boundaries and in descending order so
+    // that lanes drain at different times
+    constexpr std::size_t numJobs = 67U;
+    std::vector<std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES>> outs(numJobs);
+    std::vector<dplx_blake2b_job> jobs;
+    for (std::size_t i = 0; i < numJobs; ++i)
+    {
+        std::size_t const inlen = (in.size() - i * 15U) % in.size();
+        std::size_t const keylen = i % 3U == 0U ? 0U : i % key.size() + 1U;
+        std::size_t const outlen = i % DPLX_BLAKE2B_OUTBYTES + 1U;
+        jobs.push_back({outs[i].data(), outlen, in.data(), inlen,
+                        keylen > 0U ? key.data() : nullptr, keylen});
+    }
+
+    REQUIRE(dplx_blake2b_many(jobs.data(), jobs.size()) == 0);
+
+    for (auto const &job : jobs)
+    {
+        INFO("inlen: " << job.inlen << " keylen: " << job.keylen
+                       << " outlen: " << job.outlen);
+        std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> expected{};
+        REQUIRE(dplx_blake2b(expected.data(), job.outlen, job.in, job.inlen,
+                             job.key, job.keylen)
+                == 0);
+        CHECK_BLOB_EQ(std::span(static_cast<std::uint8_t const *>(job.out),
+                                job.outlen),
+                      std::span(expected).first(job.outlen));
+    }
+}
+
+TEST_CASE("dplx_blake2b prepared keys should match keyed dplx_blake2b()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const inlen = GENERATE(0U, 1U, 128U, 128U + 1U, 1000U);
+    INFO("inlen: " << inlen);
+
+    auto const in = make_test_input(inlen);
+    std::array<std::uint8_t, DPLX_BLAKE2B_KEYBYTES> key{};
+    for (std::size_t i = 0; i < key.size(); ++i)
+    {
+        key[i] = static_cast<std::uint8_t>(i);
+    }
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2b(expected.data(), expected.size(), in.data(),
+                         in.size(), key.data(), key.size())
+            == 0);
+
+    dplx_blake2b_prepared_key prepared{};
+    REQUIRE(dplx_blake2b_prepare_key(&prepared, DPLX_BLAKE2B_OUTBYTES,
+                                     key.data(), key.size())
+            == 0);
+
+    SECTION("with dplx_blake2b_mac()")
+    {
+        std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+        REQUIRE(dplx_blake2b_mac(&prepared, out.data(), out.size(), in.data(),
+                                 in.size())
+                == 0);
+        CHECK_BLOB_EQ(out, expected);
+    }
+    SECTION("with dplx_blake2b_init_prepared()")
+    {
+        dplx_blake2b_state state{};
+        REQUIRE(dplx_blake2b_init_prepared(&state, &prepared) == 0);
+        REQUIRE(dplx_blake2b_update(&state, in.data(), in.size()) == 0);
+        std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+        REQUIRE(dplx_blake2b_final(&state, out.data(), out.size()) == 0);
+        CHECK_BLOB_EQ(out, expected);
+    }
+    SECTION("with dplx_blake2b_mac_many()")
+    {
+        std::vector<std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES>> outs(11U);
+        std::vector<dplx_blake2b_job> jobs;
+        for (auto &out : outs)
+        {
+            jobs.push_back({out.data(), out.size(), in.data(), in.size(),
+                            nullptr, 0U});
+        }
+        REQUIRE(dplx_blake2b_mac_many(&prepared, jobs.data(), jobs.size())
+                == 0);
+        for (auto const &out : outs)
+        {
+            CHECK_BLOB_EQ(out, expected);
+        }
+    }
+}
+
+TEST_CASE("dplx_blake2b_hash_pairs() should match dplx_blake2b() for each "
+          "pair")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const outlen = GENERATE(32U, 64U);
+    std::size_t const n = GENERATE(1U, 2U, 4U, 4U + 1U, 11U);
+    INFO("outlen: " << outlen << ", n: " << n);
+
+    constexpr std::size_t pairSize = 2U * DPLX_BLAKE2_CHILDBYTES;
+    auto children = make_test_input(n * pairSize);
+
+    std::vector<std::uint8_t> expected(n * outlen);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        REQUIRE(dplx_blake2b(expected.data() + (i * outlen), outlen,
+                             children.data() + (i * pairSize), pairSize,
+                             nullptr, 0U)
+                == 0);
+    }
+
+    SECTION("with dplx_blake2b_hash_pair()")
+    {
+        std::vector<std::uint8_t> out(n * outlen);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::uint8_t const *pair = children.data() + (i * pairSize);
+            REQUIRE(dplx_blake2b_hash_pair(out.data() + (i * outlen), outlen,
+                                           pair,
+                                           pair + DPLX_BLAKE2_CHILDBYTES)
+                    == 0);
+        }
+        CHECK_BLOB_EQ(out, expected);
+    }
+    SECTION("with dplx_blake2b_hash_pairs()")
+    {
+        std::vector<std::uint8_t> out(n * outlen);
+        REQUIRE(dplx_blake2b_hash_pairs(out.data(), outlen, children.data(),
+                                        n)
+                == 0);
+        CHECK_BLOB_EQ(out, expected);
+    }
+    SECTION("with dplx_blake2b_hash_pairs() in place")
+    {
+        REQUIRE(dplx_blake2b_hash_pairs(children.data(), outlen,
+                                        children.data(), n)
+                == 0);
+        children.resize(n * outlen);
+        CHECK_BLOB_EQ(children, expected);
+    }
+}
+
+TEST_CASE("dplx_blake2b_compress() should match dplx_blake2b() for a "
+          "single block")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const inlen = GENERATE(0U, 1U, 127U, 128U);
+    INFO("inlen: " << inlen);
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_BLOCKBYTES> block{};
+    fill_test_input(std::span(block).first(inlen));
+
+    dplx_blake2b_state state{};
+    REQUIRE(dplx_blake2b_init(&state, DPLX_BLAKE2B_OUTBYTES) == 0);
+    std::uint64_t const t[2] = {static_cast<std::uint64_t>(inlen), 0U};
+    std::uint64_t const f[2] = {~std::uint64_t{}, 0U};
+    REQUIRE(dplx_blake2b_compress(state.h, block.data(), t, f) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> out{};
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        out[i] = static_cast<std::uint8_t>(state.h[i / sizeof(state.h[0])]
+                                           >> (8U * (i % sizeof(state.h[0]))));
+    }
+
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2b(expected.data(), expected.size(), block.data(), inlen,
+                         nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+}
+
+TEST_CASE("dplx_blake2xb() should correctly compute the official testvectors")
+{
+    b2_known_answer_dto ka
+            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2xb"));
+
+    INFO(ka);
+
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::vector<std::uint8_t> out(ka.out.size());
+
+    REQUIRE(dplx_blake2xb(out.data(), out.size(), ka.in.data(), ka.in.size(),
+                          ka.key.data(), ka.key.size())
+            == 0);
+
+    CHECK_BLOB_EQ(out, ka.out);
+}
+
+TEST_CASE("dplx_blake2xb_*() should correctly compute the official testvectors")
+{
+    b2_known_answer_dto ka
+            = GENERATE(load_kat_from_json("blake2-kat.json", "blake2xb"));
+
+    INFO(ka);
+
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    dplx_blake2xb_state ctx{};
+    if (ka.key.size() > 0)
+    {
+        REQUIRE(dplx_blake2xb_init_key(&ctx, ka.out.size(), ka.key.data(),
+                                       ka.key.size())
+                == 0);
+    }
+    else
+    {
+        REQUIRE(dplx_blake2xb_init(&ctx, ka.out.size()) == 0);
+    }
+
+    REQUIRE(dplx_blake2xb_update(&ctx, ka.in.data(), ka.in.size()) == 0);
+
+    std::vector<std::uint8_t> out(ka.out.size());
+    REQUIRE(dplx_blake2xb_final(&ctx, out.data(), out.size()) == 0);
+
+    CHECK_BLOB_EQ(out, ka.out);
+}
+
+TEST_CASE("dplx_blake2xb() should match the BLAKE2XB definition for long "
+          "outputs")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const outlen = GENERATE(255U, 256U, 257U, 1000U, 4097U, 70000U);
+    INFO("outlen: " << outlen);
+
+    std::array<std::uint8_t, 3> const in{'a', 'b', 'c'};
+    std::vector<std::uint8_t> out(outlen);
+    REQUIRE(dplx_blake2xb(out.data(), out.size(), in.data(), in.size(),
+                          nullptr, 0U)
+            == 0);
+
+    // the output is the concatenation of the hashes of the root hash with
+    // node_offset set to the block index
+    dplx_blake2b_param param{};
+    param.digest_length = DPLX_BLAKE2B_OUTBYTES;
+    param.fanout = 1U;
+    param.depth = 1U;
+    param.xof_length = static_cast<std::uint32_t>(outlen);
+    dplx_blake2b_state state{};
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> root{};
+    REQUIRE(dplx_blake2b_init_param(&state, &param) == 0);
+    REQUIRE(dplx_blake2b_update(&state, in.data(), in.size()) == 0);
+    REQUIRE(dplx_blake2b_final(&state, root.data(), root.size()) == 0);
+
+    std::vector<std::uint8_t> expected(outlen);
+    for (std::size_t offset = 0; offset < outlen;
+         offset += DPLX_BLAKE2B_OUTBYTES)
+    {
+        std::size_t const blockSize
+                = std::min<std::size_t>(outlen - offset, DPLX_BLAKE2B_OUTBYTES);
+        param.digest_length = static_cast<std::uint8_t>(blockSize);
+        param.fanout = 0U;
+        param.depth = 0U;
+        param.leaf_length = DPLX_BLAKE2B_OUTBYTES;
+        param.node_offset
+                = static_cast<std::uint32_t>(offset / DPLX_BLAKE2B_OUTBYTES);
+        param.inner_length = DPLX_BLAKE2B_OUTBYTES;
+        REQUIRE(dplx_blake2b_init_param(&state, &param) == 0);
+        REQUIRE(dplx_blake2b_update(&state, root.data(), root.size()) == 0);
+        REQUIRE(dplx_blake2b_final(&state, expected.data() + offset, blockSize)
+                == 0);
+    }
+    CHECK_BLOB_EQ(out, expected);
+}
+
+TEST_CASE("dplx_blake2xb_squeeze_at() should match dplx_blake2xb_final()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    constexpr std::size_t outlen = 1000U;
+    std::size_t const offset = GENERATE(0U, 1U, 63U, 64U, 300U);
+    std::size_t const size = GENERATE(0U, 1U, 17U, 64U, 579U);
+    INFO("offset: " << offset << ", size: " << size);
+
+    std::array<std::uint8_t, 3> const in{'a', 'b', 'c'};
+    dplx_blake2xb_state state{};
+    REQUIRE(dplx_blake2xb_init(&state, outlen) == 0);
+    REQUIRE(dplx_blake2xb_update(&state, in.data(), in.size()) == 0);
+    dplx_blake2xb_state seekable = state;
+
+    std::vector<std::uint8_t> expected(outlen);
+    REQUIRE(dplx_blake2xb_final(&state, expected.data(), expected.size()) == 0);
+    expected.erase(expected.begin(),
+                   expected.begin() + static_cast<std::ptrdiff_t>(offset));
+    expected.resize(size);
+
+    std::vector<std::uint8_t> out(size);
+    REQUIRE(dplx_blake2xb_squeeze_at(&seekable, offset, out.data(), out.size())
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+
+    // the root hash is finalized once, repeated reads yield the same output
+    REQUIRE(dplx_blake2xb_squeeze_at(&seekable, offset, out.data(), out.size())
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+
+    CHECK(dplx_blake2xb_squeeze_at(&seekable, outlen - size + 1U, out.data(),
+                                    out.size())
+          == -1);
+}
+
+TEST_CASE("dplx_blake2xb_squeeze() should stream the output of "
+          "dplx_blake2xb_final()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    constexpr std::size_t outlen = 1000U;
+    std::size_t const chunkSize = GENERATE(1U, 7U, 64U, 300U);
+    INFO("chunk size: " << chunkSize);
+
+    std::array<std::uint8_t, 3> const in{'a', 'b', 'c'};
+    dplx_blake2xb_state state{};
+    REQUIRE(dplx_blake2xb_init(&state, outlen) == 0);
+    REQUIRE(dplx_blake2xb_update(&state, in.data(), in.size()) == 0);
+    dplx_blake2xb_state stream = state;
+
+    std::vector<std::uint8_t> expected(outlen);
+    REQUIRE(dplx_blake2xb_final(&state, expected.data(), expected.size()) == 0);
+
+    std::vector<std::uint8_t> out(outlen);
+    for (std::size_t offset = 0; offset < outlen; offset += chunkSize)
+    {
+        REQUIRE(dplx_blake2xb_squeeze(&stream, out.data() + offset,
+                                      std::min(chunkSize, outlen - offset))
+                == 0);
+    }
+    CHECK_BLOB_EQ(out, expected);
+
+    CHECK(dplx_blake2xb_squeeze(&stream, out.data(), 1U) == -1);
+}
+
+TEST_CASE("dplx_blake2xb_state_import() should resume an exported state")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    constexpr std::size_t outlen = 1000U;
+    std::array<std::uint8_t, 3> const in{'a', 'b', 'c'};
+    dplx_blake2xb_state state{};
+    REQUIRE(dplx_blake2xb_init(&state, outlen) == 0);
+    REQUIRE(dplx_blake2xb_update(&state, in.data(), 1U) == 0);
+
+    std::array<std::uint8_t, DPLX_BLAKE2XB_STATEBYTES> serialized{};
+    REQUIRE(dplx_blake2xb_state_export(&state, serialized.data()) == 0);
+
+    dplx_blake2xb_state resumed{};
+    REQUIRE(dplx_blake2xb_state_import(&resumed, serialized.data()) == 0);
+    REQUIRE(dplx_blake2xb_update(&resumed, in.data() + 1U, in.size() - 1U)
+            == 0);
+    std::vector<std::uint8_t> out(outlen);
+    REQUIRE(dplx_blake2xb_squeeze(&resumed, out.data(), 100U) == 0);
+
+    // the squeeze position is part of the state
+    REQUIRE(dplx_blake2xb_state_export(&resumed, serialized.data()) == 0);
+    REQUIRE(dplx_blake2xb_state_import(&state, serialized.data()) == 0);
+    REQUIRE(dplx_blake2xb_squeeze(&state, out.data() + 100U, outlen - 100U)
+            == 0);
+
+    std::vector<std::uint8_t> expected(outlen);
+    REQUIRE(dplx_blake2xb(expected.data(), expected.size(), in.data(),
+                          in.size(), nullptr, 0U)
+            == 0);
+    CHECK_BLOB_EQ(out, expected);
+}
+
+TEST_CASE("dplx::blake2s<> should match dplx_blake2s()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const inlen = GENERATE(0U, 1U, 64U, 64U + 1U, 1000U);
+    INFO("inlen: " << inlen);
+
+    auto const in = make_test_input<std::byte>(inlen);
+    std::array<std::byte, DPLX_BLAKE2S_KEYBYTES> key{};
+    for (std::size_t i = 0; i < key.size(); ++i)
+    {
+        key[i] = static_cast<std::byte>(i);
+    }
+
+    SECTION("unkeyed")
+    {
+        std::array<std::uint8_t, 20U> expected{};
+        REQUIRE(dplx_blake2s(expected.data(), expected.size(), in.data(),
+                             in.size(), nullptr, 0U)
+                == 0);
+        CHECK_BLOB_EQ(dplx::blake2s<20U>::hash(in), expected);
+    }
+    SECTION("keyed")
+    {
+        std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> expected{};
+        REQUIRE(dplx_blake2s(expected.data(), expected.size(), in.data(),
+                             in.size(), key.data(), key.size())
+                == 0);
+        std::span<std::byte const, DPLX_BLAKE2S_KEYBYTES> const keyView(key);
+        dplx::blake2s<> hasher(keyView);
+        hasher.update(std::span(in).first(inlen / 2U));
+        hasher.update(std::span(in).subspan(inlen / 2U));
+        CHECK_BLOB_EQ(hasher.finalize(), expected);
+    }
+}
+
+TEST_CASE("dplx::blake2b<> should match dplx_blake2b()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const inlen = GENERATE(0U, 1U, 128U, 128U + 1U, 1000U);
+    INFO("inlen: " << inlen);
+
+    auto const in = make_test_input<std::byte>(inlen);
+    std::array<std::byte, DPLX_BLAKE2B_KEYBYTES> key{};
+    for (std::size_t i = 0; i < key.size(); ++i)
+    {
+        key[i] = static_cast<std::byte>(i);
+    }
+
+    SECTION("unkeyed")
+    {
+        std::array<std::uint8_t, 20U> expected{};
+        REQUIRE(dplx_blake2b(expected.data(), expected.size(), in.data(),
+                             in.size(), nullptr, 0U)
+                == 0);
+        CHECK_BLOB_EQ(dplx::blake2b<20U>::hash(in), expected);
+    }
+    SECTION("keyed")
+    {
+        std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> expected{};
+        REQUIRE(dplx_blake2b(expected.data(), expected.size(), in.data(),
+                             in.size(), key.data(), key.size())
+                == 0);
+        std::span<std::byte const, DPLX_BLAKE2B_KEYBYTES> const keyView(key);
+        dplx::blake2b<> hasher(keyView);
+        hasher.update(std::span(in).first(inlen / 2U));
+        hasher.update(std::span(in).subspan(inlen / 2U));
+        CHECK_BLOB_EQ(hasher.finalize(), expected);
+    }
+}
+
+TEST_CASE("dplx::blake2s_hasher should match keyed dplx_blake2s()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    std::size_t const inlen
+            = GENERATE(0U, 1U, 8U, 32U, 64U, 64U + 1U, 128U, 128U + 1U, 1000U);
+    INFO("inlen: " << inlen);
+
+    auto const in = make_test_input<std::byte>(inlen);
+    std::array<std::byte, 16U> key{};
+    for (std::size_t i = 0; i < key.size(); ++i)
+    {
+        key[i] = static_cast<std::byte>(i);
+    }
+
+    std::array<std::uint8_t, sizeof(std::size_t)> expected{};
+    REQUIRE(dplx_blake2s(expected.data(), expected.size(), in.data(),
+                         in.size(), key.data(), key.size())
+            == 0);
+    std::size_t expectedValue = 0U;
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        expectedValue |= static_cast<std::size_t>(expected[i]) << (8U * i);
+    }
+
+    dplx::blake2s_hasher const hasher(std::span<std::byte const, 16U>{key});
+    CHECK(hasher(in) == expectedValue);
+    CHECK(hasher(std::string_view(reinterpret_cast<char const *>(in.data()),
+                                  in.size()))
+          == expectedValue);
+}
+
+TEST_CASE("dplx::blake2s<>::hash_pair() should match dplx::blake2s<>::hash()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    using hasher = dplx::blake2s<>;
+    static constexpr auto children = [] {
+        std::array<std::byte, 2U * DPLX_BLAKE2_CHILDBYTES> bytes{};
+        fill_test_input(bytes);
+        return bytes;
+    }();
+    constexpr std::span<std::byte const, children.size()> view(children);
+    static constexpr auto node
+            = hasher::hash_pair(view.first<DPLX_BLAKE2_CHILDBYTES>(),
+                                view.last<DPLX_BLAKE2_CHILDBYTES>());
+
+    CHECK_BLOB_EQ(hasher::hash_pair(view.first<DPLX_BLAKE2_CHILDBYTES>(),
+                                    view.last<DPLX_BLAKE2_CHILDBYTES>()),
+                  node);
+    CHECK_BLOB_EQ(hasher::hash(view), node);
+}
+
+TEST_CASE("dplx::blake2b<>::hash_pair() should match dplx::blake2b<>::hash()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    using hasher = dplx::blake2b<>;
+    static constexpr auto children = [] {
+        std::array<std::byte, 2U * DPLX_BLAKE2_CHILDBYTES> bytes{};
+        fill_test_input(bytes);
+        return bytes;
+    }();
+    constexpr std::span<std::byte const, children.size()> view(children);
+    static constexpr auto node
+            = hasher::hash_pair(view.first<DPLX_BLAKE2_CHILDBYTES>(),
+                                view.last<DPLX_BLAKE2_CHILDBYTES>());
+
+    CHECK_BLOB_EQ(hasher::hash_pair(view.first<DPLX_BLAKE2_CHILDBYTES>(),
+                                    view.last<DPLX_BLAKE2_CHILDBYTES>()),
+                  node);
+    CHECK_BLOB_EQ(hasher::hash(view), node);
+}
+
+template <typename Hasher, std::size_t KeySize, std::size_t InSize>
+constexpr auto constexpr_kat_digest() noexcept -> typename Hasher::digest_type
+{
+    // the input and key patterns of the official testvectors
+    std::array<std::byte, InSize> in{};
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = static_cast<std::byte>(i);
+    }
+    auto hasher = [] {
+        if constexpr (KeySize == 0U)
+        {
+            return Hasher{};
+        }
+        else
+        {
+            std::array<std::byte, KeySize> key{};
+            for (std::size_t i = 0; i < key.size(); ++i)
+            {
+                key[i] = static_cast<std::byte>(i);
+            }
+            return Hasher(std::span<std::byte const, KeySize>(key));
+        }
+    }();
+    std::span<std::byte const> const view(in);
+    hasher.update(view.first(InSize / 3U));
+    hasher.update(view.subspan(InSize / 3U));
+    return hasher.finalize();
+}
+
+template <std::size_t KeySize, std::size_t InSize>
+void check_constexpr_blake2s()
+{
+    INFO("keylen: " << KeySize << ", inlen: " << InSize);
+    static constexpr auto digest
+            = constexpr_kat_digest<dplx::blake2s<>, KeySize, InSize>();
+
+    std::array<std::uint8_t, InSize> in{};
+    std::array<std::uint8_t, KeySize> key{};
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = static_cast<std::uint8_t>(i);
+    }
+    for (std::size_t i = 0; i < key.size(); ++i)
+    {
+        key[i] = static_cast<std::uint8_t>(i);
+    }
+    std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2s(expected.data(), expected.size(), in.data(),
+                         in.size(), key.data(), key.size())
+            == 0);
+    CHECK_BLOB_EQ(digest, expected);
+}
+
+TEST_CASE("dplx::blake2s<> should produce identical digests during constant "
+          "evaluation")
+{
+    // RFC 7693 Appendix B
+    static constexpr auto abc = dplx::blake2s<>::hash("abc");
+    static_assert(abc.front() == std::byte{0x50}
+                  && abc.back() == std::byte{0x82});
+
+    check_constexpr_blake2s<0U, 0U>();
+    check_constexpr_blake2s<0U, 64U>();
+    check_constexpr_blake2s<0U, 255U>();
+    check_constexpr_blake2s<DPLX_BLAKE2S_KEYBYTES, 0U>();
+    check_constexpr_blake2s<DPLX_BLAKE2S_KEYBYTES, 65U>();
+    check_constexpr_blake2s<DPLX_BLAKE2S_KEYBYTES, 255U>();
+}
+
+template <std::size_t KeySize, std::size_t InSize>
+void check_constexpr_blake2b()
+{
+    INFO("keylen: " << KeySize << ", inlen: " << InSize);
+    static constexpr auto digest
+            = constexpr_kat_digest<dplx::blake2b<>, KeySize, InSize>();
+
+    std::array<std::uint8_t, InSize> in{};
+    std::array<std::uint8_t, KeySize> key{};
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = static_cast<std::uint8_t>(i);
+    }
+    for (std::size_t i = 0; i < key.size(); ++i)
+    {
+        key[i] = static_cast<std::uint8_t>(i);
+    }
+    std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES> expected{};
+    REQUIRE(dplx_blake2b(expected.data(), expected.size(), in.data(),
+                         in.size(), key.data(), key.size())
+            == 0);
+    CHECK_BLOB_EQ(digest, expected);
+}
+
+TEST_CASE("dplx::blake2b<> should produce identical digests during constant "
+          "evaluation")
+{
+    // RFC 7693 Appendix B
+    static constexpr auto abc = dplx::blake2b<>::hash("abc");
+    static_assert(abc.front() == std::byte{0xBA}
+                  && abc.back() == std::byte{0x23});
+
+    check_constexpr_blake2b<0U, 0U>();
+    check_constexpr_blake2b<0U, 128U>();
+    check_constexpr_blake2b<0U, 255U>();
+    check_constexpr_blake2b<DPLX_BLAKE2B_KEYBYTES, 0U>();
+    check_constexpr_blake2b<DPLX_BLAKE2B_KEYBYTES, 129U>();
+    check_constexpr_blake2b<DPLX_BLAKE2B_KEYBYTES, 255U>();
+}
+
+TEST_CASE("dplx_blake2_current_implementation() should report the selected "
+          "implementation")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    INFO("impl id: " << implId);
+    REQUIRE(dplx_blake2_use_implementation(implId) == 0);
+
+    // the fallback is an alias of the default implementation which is
+    // reported instead
+    dplx_blake2_implementation_id const current
+            = dplx_blake2_current_implementation();
+    if (implId == DPLX_BLAKE2_IMPL_FALLBACK)
+    {
+        CHECK(current != DPLX_BLAKE2_IMPL_FALLBACK);
+        CHECK(dplx_blake2_has_implementation(current));
+    }
+    else
+    {
+        CHECK(current == implId);
+    }
+    CHECK(dplx_blake2_implementation_name(implId) != nullptr);
+
+    REQUIRE(dplx_blake2_choose_implementation() == 0);
+    CHECK(dplx_blake2_has_implementation(
+            dplx_blake2_current_implementation()));
+}
+
+TEST_CASE("dplx_blake2_implementation_name() should reject invalid ids")
+{
+    CHECK(dplx_blake2_implementation_name(DPLX_BLAKE2_IMPL_COUNT) == nullptr);
+}
+
+TEST_CASE("dplx_blake2_implementation_from_name() should accept the names "
+          "returned by dplx_blake2_implementation_name()")
+{
+    dplx_blake2_implementation_id implId
+            = GENERATE(available_blake2_impl_ids());
+    char const *const name = dplx_blake2_implementation_name(implId);
+    INFO("implementation: " << name);
+
+    CHECK(dplx_blake2_implementation_from_name(name) == implId);
+}
+
+TEST_CASE("dplx_blake2_implementation_from_name() should reject unknown names")
+{
+    CHECK(dplx_blake2_implementation_from_name(nullptr)
+          == DPLX_BLAKE2_IMPL_COUNT);
+    CHECK(dplx_blake2_implementation_from_name("") == DPLX_BLAKE2_IMPL_COUNT);
+    CHECK(dplx_blake2_implementation_from_name("SSE41")
+          == DPLX_BLAKE2_IMPL_COUNT);
+}
+
+#if !DPLX_BLAKE2_WITH_IFUNC
+
+TEST_CASE("dplx_blake2_autotune() should install implementations matching "
+          "the fallback one")
+{
+    auto const in = make_test_input(70000U);
+    // one length per size class and around the class boundaries
+    std::array<std::size_t, 8> const lengths{0U,    64U,    256U,   257U,
+                                             2048U, 16384U, 16385U, 70000U};
+
+    using b_out = std::array<std::uint8_t, DPLX_BLAKE2B_OUTBYTES>;
+    using s_out = std::array<std::uint8_t, DPLX_BLAKE2S_OUTBYTES>;
+    auto const hashAll = [&](std::size_t inlen, b_out &b, b_out &bp, s_out &s,
+                             s_out &sp) {
+        REQUIRE(dplx_blake2b(b.data(), b.size(), in.data(), inlen, nullptr, 0U)
+                == 0);
+        REQUIRE(dplx_blake2bp(bp.data(), bp.size(), in.data(), inlen, nullptr,
+                              0U)
+                == 0);
+        REQUIRE(dplx_blake2s(s.data(), s.size(), in.data(), inlen, nullptr, 0U)
+                == 0);
+        REQUIRE(dplx_blake2sp(sp.data(), sp.size(), in.data(), inlen, nullptr,
+                              0U)
+                == 0);
+    };
+
+    // the fallback is available regardless of the configured implementations
+    REQUIRE(dplx_blake2_use_implementation(DPLX_BLAKE2_IMPL_FALLBACK) == 0);
+    std::vector<b_out> bExpected(lengths.size());
+    std::vector<b_out> bpExpected(lengths.size());
+    std::vector<s_out> sExpected(lengths.size());
+    std::vector<s_out> spExpected(lengths.size());
+    for (std::size_t i = 0; i < lengths.size(); ++i)
+    {
+        hashAll(lengths[i], bExpected[i], bpExpected[i], sExpected[i],
+                spExpected[i]);
+    }
+
+    REQUIRE(dplx_blake2_autotune() == 0);
+    for (int alg = 0; alg < DPLX_BLAKE2_ALGORITHM_COUNT; ++alg)
+    {
+        for (int size = 0; size < DPLX_BLAKE2_SIZE_CLASS_COUNT; ++size)
+        {
+            CHECK(dplx_blake2_has_implementation(dplx_blake2_tuned_implementation(
+                    static_cast<dplx_blake2_algorithm>(alg),
+                    static_cast<dplx_blake2_size_class>(size))));
+        }
+    }
+
+    for (std::size_t i = 0; i < lengths.size(); ++i)
+    {
+        INFO("inlen: " << lengths[i]);
+        b_out bOut{};
+        b_out bpOut{};
+        s_out sOut{};
+        s_out spOut{};
+        hashAll(lengths[i], bOut, bpOut, sOut, spOut);
+        CHECK_BLOB_EQ(bOut, bExpected[i]);
+        CHECK_BLOB_EQ(bpOut, bpExpected[i]);
+        CHECK_BLOB_EQ(sOut, sExpected[i]);
+        CHECK_BLOB_EQ(spOut, spExpected[i]);
+    }
+
+    REQUIRE(dplx_blake2_choose_implementation() == 0);
+}
+
+#else
+
+TEST_CASE("dplx_blake2_autotune() should fail if the implementation is bound "
+          "at load time")
+{
+    CHECK(dplx_blake2_autotune() == -1);
+    CHECK(dplx_blake2_tuned_implementation(DPLX_BLAKE2_ALGORITHM_B,
+                                           DPLX_BLAKE2_SIZE_LARGE)
+          == dplx_blake2_current_implementation());
+}
+
+#endif
+
 } // namespace blake2_tests
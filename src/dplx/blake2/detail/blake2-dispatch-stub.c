@@ -13,6 +13,10 @@
 */
 #include "dplx/blake2.h"
 
+#include <string.h>
+
+#define X_MODE_ALL 2
+
 int dplx_blake2_choose_implementation( void )
 {
     return 0;
@@ -29,3 +33,54 @@ bool dplx_blake2_has_implementation( enum dplx_blake2_implementation_id which )
 #include "blake2-impl-type.def"
 }
 #undef X
+
+int dplx_blake2_autotune( void )
+{
+    return 0;
+}
+#define X(l, u) return DPLX_BLAKE2_IMPL_##u;
+enum dplx_blake2_implementation_id dplx_blake2_tuned_implementation( enum dplx_blake2_algorithm alg, enum dplx_blake2_size_class size )
+{
+    if ((unsigned)alg >= DPLX_BLAKE2_ALGORITHM_COUNT || (unsigned)size >= DPLX_BLAKE2_SIZE_CLASS_COUNT)
+    {
+        return DPLX_BLAKE2_IMPL_COUNT;
+    }
+#include "blake2-impl-type.def"
+}
+#undef X
+#define X(l, u) return DPLX_BLAKE2_IMPL_##u;
+enum dplx_blake2_implementation_id dplx_blake2_current_implementation( void )
+{
+#include "blake2-impl-type.def"
+}
+#undef X
+const char *dplx_blake2_implementation_name( enum dplx_blake2_implementation_id which )
+{
+    switch (which)
+    {
+        case DPLX_BLAKE2_IMPL_FALLBACK: return "fallback";
+#define X_MODE X_MODE_ALL
+#define X(l, u) case DPLX_BLAKE2_IMPL_ ## u: return #l;
+#include "blake2-impl-type.def"
+#undef X
+#undef X_MODE
+        default: return NULL;
+    }
+}
+enum dplx_blake2_implementation_id dplx_blake2_implementation_from_name( const char *name )
+{
+    if (name == NULL)
+    {
+        return DPLX_BLAKE2_IMPL_COUNT;
+    }
+    if (strcmp(name, "fallback") == 0)
+    {
+        return DPLX_BLAKE2_IMPL_FALLBACK;
+    }
+#define X_MODE X_MODE_ALL
+#define X(l, u) if (strcmp(name, #l) == 0) { return DPLX_BLAKE2_IMPL_ ## u; }
+#include "blake2-impl-type.def"
+#undef X
+#undef X_MODE
+    return DPLX_BLAKE2_IMPL_COUNT;
+}
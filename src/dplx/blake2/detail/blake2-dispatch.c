@@ -16,6 +16,17 @@
 
 #include <assert.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if DPLX_BLAKE2_DISPATCH_IFUNC
+// ifunc resolvers run while the binary is being relocated, i.e. before any
+// sanitizer runtime has been initialized
+#define DPLX_BLAKE2_RESOLVER_ATTRS __attribute__((no_sanitize("address", "undefined")))
+#else
+#define DPLX_BLAKE2_RESOLVER_ATTRS
+#endif
 
 #define X_MODE_NOT 1
 #define X_MODE_ALL 2
@@ -50,7 +61,7 @@ static_assert(sizeof(uintptr_t) == sizeof(void*), "MSVC atomic impl requires poi
 
 #endif
 
-#if DPLX_BLAKE2_DISPATCH_sse2 || DPLX_BLAKE2_DISPATCH_sse41 || DPLX_BLAKE2_DISPATCH_avx
+#if DPLX_BLAKE2_DISPATCH_sse2 || DPLX_BLAKE2_DISPATCH_ssse3 || DPLX_BLAKE2_DISPATCH_sse41 || DPLX_BLAKE2_DISPATCH_avx || DPLX_BLAKE2_DISPATCH_xop || DPLX_BLAKE2_DISPATCH_avx2 || DPLX_BLAKE2_DISPATCH_avx512
 #include <immintrin.h>
 #if defined(_MSC_VER)
 
@@ -58,6 +69,9 @@ static_assert(sizeof(uintptr_t) == sizeof(void*), "MSVC atomic impl requires poi
 #if !defined(bit_SSE2)
 #define bit_SSE2 0x04000000
 #endif
+#if !defined(bit_SSSE3)
+#define bit_SSSE3 0x00000200
+#endif
 #if !defined(bit_SSE4_1)
 #define bit_SSE4_1 0x00080000
 #endif
@@ -67,9 +81,21 @@ static_assert(sizeof(uintptr_t) == sizeof(void*), "MSVC atomic impl requires poi
 #if !defined(bit_OSXSAVE)
 #define bit_OSXSAVE 0x08000000
 #endif
-static inline int dplx_get_cpuid(unsigned const level, unsigned *const eax,
-                                 unsigned *const ebx, unsigned *const ecx,
-                                 unsigned *const edx)
+#if !defined(bit_XOP)
+#define bit_XOP 0x00000800
+#endif
+#if !defined(bit_AVX2)
+#define bit_AVX2 0x00000020
+#endif
+#if !defined(bit_AVX512F)
+#define bit_AVX512F 0x00010000
+#endif
+#if !defined(bit_AVX512VL)
+#define bit_AVX512VL 0x80000000
+#endif
+static inline int dplx_get_cpuid_count(unsigned const level, unsigned const subleaf,
+                                       unsigned *const eax, unsigned *const ebx,
+                                       unsigned *const ecx, unsigned *const edx)
 {
     // see https://learn.microsoft.com/en-us/cpp/intrinsics/cpuid-cpuidex
     int regs[4] = {0};
@@ -79,7 +105,7 @@ static inline int dplx_get_cpuid(unsigned const level, unsigned *const eax,
     {
         return 0;
     }
-    __cpuid(regs, level);
+    __cpuidex(regs, (int)level, (int)subleaf);
     *eax = (unsigned)regs[0];
     *ebx = (unsigned)regs[1];
     *ecx = (unsigned)regs[2];
@@ -90,11 +116,20 @@ static inline int dplx_get_cpuid(unsigned const level, unsigned *const eax,
 #elif defined(__GNUC__)
 
 #include <cpuid.h>
-static inline int dplx_get_cpuid(unsigned const level, unsigned *const eax,
-                                 unsigned *const ebx, unsigned *const ecx,
-                                 unsigned *const edx)
+DPLX_BLAKE2_RESOLVER_ATTRS
+static inline int dplx_get_cpuid_count(unsigned const level, unsigned const subleaf,
+                                       unsigned *const eax, unsigned *const ebx,
+                                       unsigned *const ecx, unsigned *const edx)
 {
-    return __get_cpuid(level, eax, ebx, ecx, edx);
+    // equivalent to __get_cpuid_count() which is subject to instrumentation
+    unsigned maxLevel = 0, unused1 = 0, unused2 = 0, unused3 = 0;
+    __cpuid(level & 0x80000000U, maxLevel, unused1, unused2, unused3);
+    if (maxLevel < level)
+    {
+        return 0;
+    }
+    __cpuid_count(level, subleaf, *eax, *ebx, *ecx, *edx);
+    return 1;
 }
 
 #else
@@ -102,23 +137,89 @@ static inline int dplx_get_cpuid(unsigned const level, unsigned *const eax,
 #error "don't know how to invoke cpuid on your compiler"
 
 #endif
+DPLX_BLAKE2_RESOLVER_ATTRS
+static inline int dplx_get_cpuid(unsigned const level, unsigned *const eax,
+                                 unsigned *const ebx, unsigned *const ecx,
+                                 unsigned *const edx)
+{
+    return dplx_get_cpuid_count(level, 0, eax, ebx, ecx, edx);
+}
 #endif
 
-#define X_FOR_BLAKE2B_API(X, suffix) \
-    X(int, dplx_blake2b_init ## suffix, ( blake2b_state *S, size_t outlen ), ( S, outlen )) \
-    X(int, dplx_blake2b_init_key ## suffix, ( blake2b_state *S, size_t outlen, const void *key, size_t keylen ), ( S, outlen, key, keylen )) \
-    X(int, dplx_blake2b_init_param ## suffix, ( blake2b_state *S, const blake2b_param *P ), ( S, P )) \
-    X(int, dplx_blake2b_update ## suffix, ( blake2b_state *S, const void *in, size_t inlen ), ( S, in, inlen )) \
-    X(int, dplx_blake2b_final ## suffix, ( blake2b_state *S, void *out, size_t outlen ), ( S, out, outlen )) \
-    X(int, dplx_blake2b ## suffix, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen ))
-
-#define X_FOR_BLAKE2S_API(X, suffix) \
-    X(int, dplx_blake2s_init ## suffix, ( blake2s_state *S, size_t outlen ), ( S, outlen )) \
-    X(int, dplx_blake2s_init_key ## suffix, ( blake2s_state *S, size_t outlen, const void *key, size_t keylen ), ( S, outlen, key, keylen )) \
-    X(int, dplx_blake2s_init_param ## suffix, ( blake2s_state *S, const blake2s_param *P ), ( S, P )) \
-    X(int, dplx_blake2s_update ## suffix, ( blake2s_state *S, const void *in, size_t inlen ), ( S, in, inlen )) \
-    X(int, dplx_blake2s_final ## suffix, ( blake2s_state *S, void *out, size_t outlen ), ( S, out, outlen )) \
-    X(int, dplx_blake2s ## suffix, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen ))
+#define X_FOR_BLAKE2B_SEQ_API(X, suffix) \
+    X(int, dplx_blake2b_init, suffix, ( blake2b_state *S, size_t outlen ), ( S, outlen )) \
+    X(int, dplx_blake2b_init_key, suffix, ( blake2b_state *S, size_t outlen, const void *key, size_t keylen ), ( S, outlen, key, keylen )) \
+    X(int, dplx_blake2b_init_param, suffix, ( blake2b_state *S, const blake2b_param *P ), ( S, P )) \
+    X(int, dplx_blake2b_update, suffix, ( blake2b_state *S, const void *in, size_t inlen ), ( S, in, inlen )) \
+    X(int, dplx_blake2b_updatev, suffix, ( blake2b_state *S, const dplx_blake2_iovec *iov, size_t n ), ( S, iov, n )) \
+    X(int, dplx_blake2b_final, suffix, ( blake2b_state *S, void *out, size_t outlen ), ( S, out, outlen )) \
+    X(int, dplx_blake2b_final_with_data, suffix, ( blake2b_state *S, const void *in, size_t inlen, void *out, size_t outlen ), ( S, in, inlen, out, outlen )) \
+    X(int, dplx_blake2b, suffix, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen )) \
+    X(int, dplx_blake2b_compress, suffix, ( uint64_t h[8], const void *block, const uint64_t t[2], const uint64_t f[2] ), ( h, block, t, f )) \
+    X(int, dplx_blake2b_hash_pair, suffix, ( void *out, size_t outlen, const void *left, const void *right ), ( out, outlen, left, right )) \
+    X(int, dplx_blake2b_prepare_key, suffix, ( dplx_blake2b_prepared_key *K, size_t outlen, const void *key, size_t keylen ), ( K, outlen, key, keylen )) \
+    X(int, dplx_blake2b_init_prepared, suffix, ( blake2b_state *S, const dplx_blake2b_prepared_key *K ), ( S, K )) \
+    X(int, dplx_blake2b_mac, suffix, ( const dplx_blake2b_prepared_key *K, void *out, size_t outlen, const void *in, size_t inlen ), ( K, out, outlen, in, inlen )) \
+    X(int, dplx_blake2b_compact_init, suffix, ( dplx_blake2b_compact_state *C, size_t outlen ), ( C, outlen )) \
+    X(int, dplx_blake2b_compact_update, suffix, ( dplx_blake2b_compact_state *C, const void *in, size_t inlen ), ( C, in, inlen )) \
+    X(int, dplx_blake2b_compact_final, suffix, ( dplx_blake2b_compact_state *C, const void *in, size_t inlen, void *out, size_t outlen ), ( C, in, inlen, out, outlen )) \
+    X(int, dplx_blake2xb_init, suffix, ( blake2xb_state *S, size_t outlen ), ( S, outlen )) \
+    X(int, dplx_blake2xb_init_key, suffix, ( blake2xb_state *S, size_t outlen, const void *key, size_t keylen ), ( S, outlen, key, keylen )) \
+    X(int, dplx_blake2xb_update, suffix, ( blake2xb_state *S, const void *in, size_t inlen ), ( S, in, inlen )) \
+    X(int, dplx_blake2xb_final, suffix, ( blake2xb_state *S, void *out, size_t outlen ), ( S, out, outlen )) \
+    X(int, dplx_blake2xb_squeeze_at, suffix, ( blake2xb_state *S, uint64_t offset, void *out, size_t outlen ), ( S, offset, out, outlen )) \
+    X(int, dplx_blake2xb_squeeze, suffix, ( blake2xb_state *S, void *out, size_t outlen ), ( S, out, outlen )) \
+    X(int, dplx_blake2xb, suffix, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen ))
+
+// the multi-buffer API shares the lane kernels with the tree mode
+#define X_FOR_BLAKE2BP_API(X, suffix) \
+    X(int, dplx_blake2bp_init, suffix, ( blake2bp_state *S, size_t outlen ), ( S, outlen )) \
+    X(int, dplx_blake2bp_init_key, suffix, ( blake2bp_state *S, size_t outlen, const void *key, size_t keylen ), ( S, outlen, key, keylen )) \
+    X(int, dplx_blake2bp_update, suffix, ( blake2bp_state *S, const void *in, size_t inlen ), ( S, in, inlen )) \
+    X(int, dplx_blake2bp_final, suffix, ( blake2bp_state *S, void *out, size_t outlen ), ( S, out, outlen )) \
+    X(int, dplx_blake2bp, suffix, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen )) \
+    X(int, dplx_blake2b_many, suffix, ( const dplx_blake2b_job *jobs, size_t n ), ( jobs, n )) \
+    X(int, dplx_blake2b_mac_many, suffix, ( const dplx_blake2b_prepared_key *K, const dplx_blake2b_job *jobs, size_t n ), ( K, jobs, n )) \
+    X(int, dplx_blake2b_hash_pairs, suffix, ( void *out, size_t outlen, const void *children, size_t n ), ( out, outlen, children, n ))
+
+#define X_FOR_BLAKE2B_API(X, suffix) X_FOR_BLAKE2B_SEQ_API(X, suffix) X_FOR_BLAKE2BP_API(X, suffix)
+
+#define X_FOR_BLAKE2S_SEQ_API(X, suffix) \
+    X(int, dplx_blake2s_init, suffix, ( blake2s_state *S, size_t outlen ), ( S, outlen )) \
+    X(int, dplx_blake2s_init_key, suffix, ( blake2s_state *S, size_t outlen, const void *key, size_t keylen ), ( S, outlen, key, keylen )) \
+    X(int, dplx_blake2s_init_param, suffix, ( blake2s_state *S, const blake2s_param *P ), ( S, P )) \
+    X(int, dplx_blake2s_update, suffix, ( blake2s_state *S, const void *in, size_t inlen ), ( S, in, inlen )) \
+    X(int, dplx_blake2s_updatev, suffix, ( blake2s_state *S, const dplx_blake2_iovec *iov, size_t n ), ( S, iov, n )) \
+    X(int, dplx_blake2s_final, suffix, ( blake2s_state *S, void *out, size_t outlen ), ( S, out, outlen )) \
+    X(int, dplx_blake2s_final_with_data, suffix, ( blake2s_state *S, const void *in, size_t inlen, void *out, size_t outlen ), ( S, in, inlen, out, outlen )) \
+    X(int, dplx_blake2s, suffix, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen )) \
+    X(int, dplx_blake2s_compress, suffix, ( uint32_t h[8], const void *block, const uint32_t t[2], const uint32_t f[2] ), ( h, block, t, f )) \
+    X(int, dplx_blake2s_hash_pair, suffix, ( void *out, size_t outlen, const void *left, const void *right ), ( out, outlen, left, right )) \
+    X(int, dplx_blake2s_prepare_key, suffix, ( dplx_blake2s_prepared_key *K, size_t outlen, const void *key, size_t keylen ), ( K, outlen, key, keylen )) \
+    X(int, dplx_blake2s_init_prepared, suffix, ( blake2s_state *S, const dplx_blake2s_prepared_key *K ), ( S, K )) \
+    X(int, dplx_blake2s_mac, suffix, ( const dplx_blake2s_prepared_key *K, void *out, size_t outlen, const void *in, size_t inlen ), ( K, out, outlen, in, inlen )) \
+    X(int, dplx_blake2s_compact_init, suffix, ( dplx_blake2s_compact_state *C, size_t outlen ), ( C, outlen )) \
+    X(int, dplx_blake2s_compact_update, suffix, ( dplx_blake2s_compact_state *C, const void *in, size_t inlen ), ( C, in, inlen )) \
+    X(int, dplx_blake2s_compact_final, suffix, ( dplx_blake2s_compact_state *C, const void *in, size_t inlen, void *out, size_t outlen ), ( C, in, inlen, out, outlen )) \
+    X(int, dplx_blake2xs_init, suffix, ( blake2xs_state *S, size_t outlen ), ( S, outlen )) \
+    X(int, dplx_blake2xs_init_key, suffix, ( blake2xs_state *S, size_t outlen, const void *key, size_t keylen ), ( S, outlen, key, keylen )) \
+    X(int, dplx_blake2xs_update, suffix, ( blake2xs_state *S, const void *in, size_t inlen ), ( S, in, inlen )) \
+    X(int, dplx_blake2xs_final, suffix, ( blake2xs_state *S, void *out, size_t outlen ), ( S, out, outlen )) \
+    X(int, dplx_blake2xs_squeeze_at, suffix, ( blake2xs_state *S, uint64_t offset, void *out, size_t outlen ), ( S, offset, out, outlen )) \
+    X(int, dplx_blake2xs_squeeze, suffix, ( blake2xs_state *S, void *out, size_t outlen ), ( S, out, outlen )) \
+    X(int, dplx_blake2xs, suffix, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen ))
+
+#define X_FOR_BLAKE2SP_API(X, suffix) \
+    X(int, dplx_blake2sp_init, suffix, ( blake2sp_state *S, size_t outlen ), ( S, outlen )) \
+    X(int, dplx_blake2sp_init_key, suffix, ( blake2sp_state *S, size_t outlen, const void *key, size_t keylen ), ( S, outlen, key, keylen )) \
+    X(int, dplx_blake2sp_update, suffix, ( blake2sp_state *S, const void *in, size_t inlen ), ( S, in, inlen )) \
+    X(int, dplx_blake2sp_final, suffix, ( blake2sp_state *S, void *out, size_t outlen ), ( S, out, outlen )) \
+    X(int, dplx_blake2sp, suffix, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen )) \
+    X(int, dplx_blake2s_many, suffix, ( const dplx_blake2s_job *jobs, size_t n ), ( jobs, n )) \
+    X(int, dplx_blake2s_mac_many, suffix, ( const dplx_blake2s_prepared_key *K, const dplx_blake2s_job *jobs, size_t n ), ( K, jobs, n )) \
+    X(int, dplx_blake2s_hash_pairs, suffix, ( void *out, size_t outlen, const void *children, size_t n ), ( out, outlen, children, n ))
+
+#define X_FOR_BLAKE2S_API(X, suffix) X_FOR_BLAKE2S_SEQ_API(X, suffix) X_FOR_BLAKE2SP_API(X, suffix)
 
 #define X_FOR_BLAKE2_API(X, suffix) X_FOR_BLAKE2B_API(X, suffix) X_FOR_BLAKE2S_API(X, suffix)
 
@@ -154,7 +255,13 @@ static inline enum dplx_blake2_implementation_slot dplx_blake2_impl_to_slot(enum
     }
 }
 
-#define X_DISPATCH_TRAMPOLINE(ret, name, params, args) \
+#if DPLX_BLAKE2_DISPATCH_IFUNC
+// the public functions are bound by the dynamic loader, see the ifunc
+// resolvers further below
+#define X_DISPATCH_TRAMPOLINE(ret, name, suffix, params, args) \
+    typedef ret (*name##_fn_t) params ;
+#else
+#define X_DISPATCH_TRAMPOLINE(ret, name, suffix, params, args) \
     static ret name##_dispatch params ; \
     typedef ret (*name##_fn_t) params ; \
     static DPLX_BLAKE2_ATOMIC_PTR_T(name##_fn_t) name##_fn = & name##_dispatch ; \
@@ -162,64 +269,209 @@ static inline enum dplx_blake2_implementation_slot dplx_blake2_impl_to_slot(enum
     { \
         return DPLX_BLAKE2_ATOMIC_PTR_LOAD_RELAXED(name##_fn_t, &name##_fn) args ; \
     }
+#endif
 X_FOR_BLAKE2_API(X_DISPATCH_TRAMPOLINE,)
 #undef X_DISPATCH_TRAMPOLINE
 
-#define X_IMPL_DECL(ret, name, params, args) ret name params;
+#define X_IMPL_DECL(ret, name, suffix, params, args) ret name ## suffix params;
 #define X(l, u) X_FOR_BLAKE2_API(X_IMPL_DECL, _##l)
 #include "blake2-impl-type.def"
 #undef X
 #undef X_IMPL_DECL
 
 typedef struct dplx_blake2_impl_vtable {
-#define X_VTABLE_MEMBER(ret, name, params, args) name##_fn_t name;
+#define X_VTABLE_MEMBER(ret, name, suffix, params, args) name##_fn_t name;
 X_FOR_BLAKE2_API(X_VTABLE_MEMBER,)
 #undef X_VTABLE_MEMBER
 } dplx_blake2_impl_vtable_t;
 
 static dplx_blake2_impl_vtable_t const dplx_blake2_impl_vtables[DPLX_BLAKE2_IMPL_SLOT_COUNT] = {
-#define X_VTABLE_VALUE(ret, name, params, args) & name ,
+#define X_VTABLE_VALUE(ret, name, suffix, params, args) & name ## suffix ,
 #define X(l, u) {X_FOR_BLAKE2_API(X_VTABLE_VALUE, _##l)},
 #include "blake2-impl-type.def"
 #undef X
 #undef X_VTABLE_VALUE
 };
 
-static inline int dplx_blake2_choose_impl()
+// returns a bitset of the slots whose instruction set extensions are supported
+// by the executing processor
+DPLX_BLAKE2_RESOLVER_ATTRS
+static inline unsigned dplx_blake2_supported_slots()
 {
-    enum dplx_blake2_implementation_slot which = DPLX_BLAKE2_IMPL_SLOT_FALLBACK;
+    unsigned supported = 1U << DPLX_BLAKE2_IMPL_SLOT_FALLBACK;
 
-#if DPLX_BLAKE2_DISPATCH_sse2 || DPLX_BLAKE2_DISPATCH_sse41 || DPLX_BLAKE2_DISPATCH_avx
+#if DPLX_BLAKE2_DISPATCH_sse2 || DPLX_BLAKE2_DISPATCH_ssse3 || DPLX_BLAKE2_DISPATCH_sse41 || DPLX_BLAKE2_DISPATCH_avx || DPLX_BLAKE2_DISPATCH_xop || DPLX_BLAKE2_DISPATCH_avx2 || DPLX_BLAKE2_DISPATCH_avx512
     unsigned eax = 0, ebx = 0, ecx = 0, edx = 0; \
     (void)dplx_get_cpuid(1, &eax, &ebx, &ecx, &edx);
 
 #if DPLX_BLAKE2_DISPATCH_sse2
-    if ((edx & bit_SSE2) == bit_SSE2) { which = DPLX_BLAKE2_IMPL_SLOT_SSE2; }
+    if ((edx & bit_SSE2) == bit_SSE2) { supported |= 1U << DPLX_BLAKE2_IMPL_SLOT_SSE2; }
+#endif
+#if DPLX_BLAKE2_DISPATCH_ssse3
+    if ((ecx & bit_SSSE3) == bit_SSSE3) { supported |= 1U << DPLX_BLAKE2_IMPL_SLOT_SSSE3; }
 #endif
 #if DPLX_BLAKE2_DISPATCH_sse41
-    if ((ecx & bit_SSE4_1) == bit_SSE4_1) { which = DPLX_BLAKE2_IMPL_SLOT_SSE41; }
+    if ((ecx & bit_SSE4_1) == bit_SSE4_1) { supported |= 1U << DPLX_BLAKE2_IMPL_SLOT_SSE41; }
 #endif
-#if DPLX_BLAKE2_DISPATCH_avx
+#if DPLX_BLAKE2_DISPATCH_avx || DPLX_BLAKE2_DISPATCH_xop || DPLX_BLAKE2_DISPATCH_avx2 || DPLX_BLAKE2_DISPATCH_avx512
     // constants have been taken from "Intel 64 and IA-32 Architectures Software Developer's Manual"
     unsigned long long const bit_XSAVE_SSE_SUPPORT = 0x2;
     unsigned long long const bit_XSAVE_AVX_SUPPORT = 0x4;
+    unsigned long long const bit_XSAVE_AVX512_SUPPORT = 0xe0; // opmask, ZMM_Hi256 & Hi16_ZMM
     unsigned long long const REQUIRED_XSAVE_SUPPORT = bit_XSAVE_SSE_SUPPORT | bit_XSAVE_AVX_SUPPORT;
-    if ((ecx & (bit_AVX | bit_OSXSAVE)) == (bit_AVX | bit_OSXSAVE)
-        && (_xgetbv(0) & REQUIRED_XSAVE_SUPPORT) == REQUIRED_XSAVE_SUPPORT)
+    bool const hasOSXSAVE = (ecx & bit_OSXSAVE) == bit_OSXSAVE;
+    unsigned long long const xcr0 = hasOSXSAVE ? _xgetbv(0) : 0;
+    bool const hasAVX = (ecx & bit_AVX) == bit_AVX
+        && (xcr0 & REQUIRED_XSAVE_SUPPORT) == REQUIRED_XSAVE_SUPPORT;
+#endif
+#if DPLX_BLAKE2_DISPATCH_avx
+    if (hasAVX)
     {
-        which = DPLX_BLAKE2_IMPL_SLOT_AVX;
+        supported |= 1U << DPLX_BLAKE2_IMPL_SLOT_AVX;
+    }
+#endif
+#if DPLX_BLAKE2_DISPATCH_xop
+    // XOP support is reported by the extended processor info leaf
+    if (hasAVX && dplx_get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx)
+        && (ecx & bit_XOP) == bit_XOP)
+    {
+        supported |= 1U << DPLX_BLAKE2_IMPL_SLOT_XOP;
+    }
+#endif
+#if DPLX_BLAKE2_DISPATCH_avx2 || DPLX_BLAKE2_DISPATCH_avx512
+    // AVX2 & AVX-512 support is reported by the structured extended feature flags leaf
+    if (!hasAVX || !dplx_get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    {
+        ebx = 0;
+    }
+#endif
+#if DPLX_BLAKE2_DISPATCH_avx2
+    if ((ebx & bit_AVX2) == bit_AVX2)
+    {
+        supported |= 1U << DPLX_BLAKE2_IMPL_SLOT_AVX2;
+    }
+#endif
+#if DPLX_BLAKE2_DISPATCH_avx512
+    if ((ebx & (bit_AVX2 | bit_AVX512F | bit_AVX512VL)) == (bit_AVX2 | bit_AVX512F | bit_AVX512VL)
+        && (xcr0 & bit_XSAVE_AVX512_SUPPORT) == bit_XSAVE_AVX512_SUPPORT)
+    {
+        supported |= 1U << DPLX_BLAKE2_IMPL_SLOT_AVX512;
     }
 #endif
 #endif
 
 #if DPLX_BLAKE2_DISPATCH_neon
-    which = DPLX_BLAKE2_IMPL_SLOT_NEON;
+    supported |= 1U << DPLX_BLAKE2_IMPL_SLOT_NEON;
 #endif
 
-    return (int)which;
+    return supported;
+}
+DPLX_BLAKE2_RESOLVER_ATTRS
+static inline int dplx_blake2_detect_impl()
+{
+    // slots are ordered by preference, i.e. pick the most capable one
+    unsigned const supported = dplx_blake2_supported_slots();
+    int which = DPLX_BLAKE2_IMPL_SLOT_FALLBACK;
+    for (int slot = 0; slot < DPLX_BLAKE2_IMPL_SLOT_COUNT; ++slot)
+    {
+        if (supported & (1U << slot))
+        {
+            which = slot;
+        }
+    }
+    return which;
+}
+
+static inline enum dplx_blake2_implementation_id dplx_blake2_slot_to_impl(enum dplx_blake2_implementation_slot slot)
+{
+    switch (slot)
+    {
+#define X(l, u) case DPLX_BLAKE2_IMPL_SLOT_ ## u: return DPLX_BLAKE2_IMPL_ ## u;
+#include "blake2-impl-type.def"
+#undef X
+        default: return DPLX_BLAKE2_IMPL_FALLBACK;
+    }
+}
+
+#if DPLX_BLAKE2_DISPATCH_IFUNC
+
+// The public functions are GNU indirect functions which the dynamic loader
+// binds directly to the implementation chosen by feature detection. The
+// binding is permanent, i.e. neither DPLX_BLAKE2_IMPL nor the selection
+// functions can replace it.
+#define X_DEF_IFUNC(ret, name, suffix, params, args) \
+    DPLX_BLAKE2_RESOLVER_ATTRS \
+    static name##_fn_t name ## _resolve( void ) \
+    { \
+        return dplx_blake2_impl_vtables[dplx_blake2_detect_impl()]. name ; \
+    } \
+    ret name params __attribute__((ifunc(#name "_resolve")));
+X_FOR_BLAKE2_API(X_DEF_IFUNC,)
+#undef X_DEF_IFUNC
+
+int dplx_blake2_autotune( void )
+{
+    return -1;
+}
+enum dplx_blake2_implementation_id dplx_blake2_tuned_implementation( enum dplx_blake2_algorithm alg, enum dplx_blake2_size_class size )
+{
+    if ((unsigned)alg >= DPLX_BLAKE2_ALGORITHM_COUNT || (unsigned)size >= DPLX_BLAKE2_SIZE_CLASS_COUNT)
+    {
+        return DPLX_BLAKE2_IMPL_COUNT;
+    }
+    return dplx_blake2_slot_to_impl(dplx_blake2_detect_impl());
+}
+
+int dplx_blake2_choose_implementation( void )
+{
+    return 0;
+}
+int dplx_blake2_use_implementation( enum dplx_blake2_implementation_id which )
+{
+    return dplx_blake2_has_implementation(which) ? 0 : -1;
+}
+bool dplx_blake2_has_implementation( enum dplx_blake2_implementation_id which )
+{
+    return which == DPLX_BLAKE2_IMPL_FALLBACK
+        || dplx_blake2_impl_to_slot(which) == dplx_blake2_detect_impl();
+}
+
+#else
+
+// returns the slot named by the DPLX_BLAKE2_IMPL environment variable if it
+// is supported by the executing processor
+static inline int dplx_blake2_env_impl()
+{
+    enum dplx_blake2_implementation_id const which
+        = dplx_blake2_implementation_from_name(getenv("DPLX_BLAKE2_IMPL"));
+    if (!dplx_blake2_has_implementation(which))
+    {
+        return DPLX_BLAKE2_IMPL_SLOT_INVALID;
+    }
+    return dplx_blake2_impl_to_slot(which);
+}
+
+// the implementation chosen on first use
+static DPLX_BLAKE2_ATOMIC_PTR_T(dplx_blake2_impl_vtable_t const *) dplx_blake2_preferred = NULL;
+
+static inline int dplx_blake2_choose_impl()
+{
+    dplx_blake2_impl_vtable_t const *preferred
+        = DPLX_BLAKE2_ATOMIC_PTR_LOAD_RELAXED(dplx_blake2_impl_vtable_t const *, &dplx_blake2_preferred);
+    if (preferred == NULL)
+    {
+        int which = dplx_blake2_env_impl();
+        if (which == DPLX_BLAKE2_IMPL_SLOT_INVALID)
+        {
+            which = dplx_blake2_detect_impl();
+        }
+        preferred = &dplx_blake2_impl_vtables[which];
+        DPLX_BLAKE2_ATOMIC_PTR_STORE_RELAXED(dplx_blake2_impl_vtable_t const *, &dplx_blake2_preferred, preferred);
+    }
+    return (int)(preferred - dplx_blake2_impl_vtables);
 }
 
-#define X_DEF_DISPATCH(ret, name, params, args) ret name ## _dispatch params { \
+#define X_DEF_DISPATCH(ret, name, suffix, params, args) ret name ## _dispatch params { \
         enum dplx_blake2_implementation_slot const slot = dplx_blake2_choose_impl(); \
         if (slot == DPLX_BLAKE2_IMPL_SLOT_INVALID) { return -1; } \
         name##_fn_t const fn = dplx_blake2_impl_vtables[slot]. name ; \
@@ -229,25 +481,258 @@ static inline int dplx_blake2_choose_impl()
 X_FOR_BLAKE2_API(X_DEF_DISPATCH,)
 #undef X_DEF_DISPATCH
 
+static inline enum dplx_blake2_size_class dplx_blake2_size_class_of(size_t inlen)
+{
+    return inlen <= 256 ? DPLX_BLAKE2_SIZE_SMALL
+         : inlen <= 16 * 1024 ? DPLX_BLAKE2_SIZE_MEDIUM
+         : DPLX_BLAKE2_SIZE_LARGE;
+}
+
+typedef dplx_blake2_impl_vtable_t const *dplx_blake2_selection_t[DPLX_BLAKE2_ALGORITHM_COUNT][DPLX_BLAKE2_SIZE_CLASS_COUNT];
+
+// the implementations processing each size class of each algorithm; NULL
+// until an implementation has been selected explicitly
+static DPLX_BLAKE2_ATOMIC_PTR_T(dplx_blake2_impl_vtable_t const *) dplx_blake2_selection[DPLX_BLAKE2_ALGORITHM_COUNT][DPLX_BLAKE2_SIZE_CLASS_COUNT];
+
+#define X_DEF_TUNED(ret, name, alg, params, args) \
+    static ret name ## _tuned params \
+    { \
+        dplx_blake2_impl_vtable_t const *vtable = DPLX_BLAKE2_ATOMIC_PTR_LOAD_RELAXED( \
+                dplx_blake2_impl_vtable_t const *, &dplx_blake2_selection[alg][dplx_blake2_size_class_of(inlen)]); \
+        if (vtable == NULL) { vtable = &dplx_blake2_impl_vtables[dplx_blake2_choose_impl()]; } \
+        return vtable-> name args; \
+    }
+X_DEF_TUNED(int, dplx_blake2b_update, DPLX_BLAKE2_ALGORITHM_B, ( blake2b_state *S, const void *in, size_t inlen ), ( S, in, inlen ))
+X_DEF_TUNED(int, dplx_blake2b, DPLX_BLAKE2_ALGORITHM_B, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen ))
+X_DEF_TUNED(int, dplx_blake2bp_update, DPLX_BLAKE2_ALGORITHM_BP, ( blake2bp_state *S, const void *in, size_t inlen ), ( S, in, inlen ))
+X_DEF_TUNED(int, dplx_blake2bp, DPLX_BLAKE2_ALGORITHM_BP, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen ))
+X_DEF_TUNED(int, dplx_blake2s_update, DPLX_BLAKE2_ALGORITHM_S, ( blake2s_state *S, const void *in, size_t inlen ), ( S, in, inlen ))
+X_DEF_TUNED(int, dplx_blake2s, DPLX_BLAKE2_ALGORITHM_S, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen ))
+X_DEF_TUNED(int, dplx_blake2sp_update, DPLX_BLAKE2_ALGORITHM_SP, ( blake2sp_state *S, const void *in, size_t inlen ), ( S, in, inlen ))
+X_DEF_TUNED(int, dplx_blake2sp, DPLX_BLAKE2_ALGORITHM_SP, ( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen ), ( out, outlen, in, inlen, key, keylen ))
+#undef X_DEF_TUNED
+
+static void dplx_blake2_install( dplx_blake2_selection_t const selection )
+{
+    for (int alg = 0; alg < DPLX_BLAKE2_ALGORITHM_COUNT; ++alg)
+    {
+        for (int size = 0; size < DPLX_BLAKE2_SIZE_CLASS_COUNT; ++size)
+        {
+            DPLX_BLAKE2_ATOMIC_PTR_STORE_RELAXED(dplx_blake2_impl_vtable_t const *,
+                                                 &dplx_blake2_selection[alg][size], selection[alg][size]);
+        }
+    }
+
+#define X_SET_IMPL(ret, name, suffix, params, args) DPLX_BLAKE2_ATOMIC_PTR_STORE_RELAXED(name##_fn_t, &name##_fn, vtable-> name );
+#define X_SET_TUNED(name) DPLX_BLAKE2_ATOMIC_PTR_STORE_RELAXED(name##_fn_t, &name##_fn, & name##_tuned );
+    for (int alg = 0; alg < DPLX_BLAKE2_ALGORITHM_COUNT; ++alg)
+    {
+        dplx_blake2_impl_vtable_t const *const vtable = selection[alg][DPLX_BLAKE2_SIZE_SMALL];
+        // the update and simple functions switch implementations depending on
+        // the input length if necessary
+        bool const sized = selection[alg][DPLX_BLAKE2_SIZE_SMALL] != selection[alg][DPLX_BLAKE2_SIZE_MEDIUM]
+                        || selection[alg][DPLX_BLAKE2_SIZE_MEDIUM] != selection[alg][DPLX_BLAKE2_SIZE_LARGE];
+        switch (alg)
+        {
+            case DPLX_BLAKE2_ALGORITHM_B:
+                X_FOR_BLAKE2B_SEQ_API(X_SET_IMPL,)
+                if (sized) { X_SET_TUNED(dplx_blake2b_update) X_SET_TUNED(dplx_blake2b) }
+                break;
+            case DPLX_BLAKE2_ALGORITHM_S:
+                X_FOR_BLAKE2S_SEQ_API(X_SET_IMPL,)
+                if (sized) { X_SET_TUNED(dplx_blake2s_update) X_SET_TUNED(dplx_blake2s) }
+                break;
+            case DPLX_BLAKE2_ALGORITHM_BP:
+                X_FOR_BLAKE2BP_API(X_SET_IMPL,)
+                if (sized) { X_SET_TUNED(dplx_blake2bp_update) X_SET_TUNED(dplx_blake2bp) }
+                break;
+            case DPLX_BLAKE2_ALGORITHM_SP:
+                X_FOR_BLAKE2SP_API(X_SET_IMPL,)
+                if (sized) { X_SET_TUNED(dplx_blake2sp_update) X_SET_TUNED(dplx_blake2sp) }
+                break;
+        }
+    }
+#undef X_SET_TUNED
+#undef X_SET_IMPL
+}
+
+static void dplx_blake2_use_slot( enum dplx_blake2_implementation_slot slot )
+{
+    dplx_blake2_selection_t selection;
+    for (int alg = 0; alg < DPLX_BLAKE2_ALGORITHM_COUNT; ++alg)
+    {
+        for (int size = 0; size < DPLX_BLAKE2_SIZE_CLASS_COUNT; ++size)
+        {
+            selection[alg][size] = &dplx_blake2_impl_vtables[slot];
+        }
+    }
+    dplx_blake2_install(selection);
+}
+
+typedef int (*dplx_blake2_simple_fn_t)( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen );
+
+static dplx_blake2_simple_fn_t dplx_blake2_simple_fn( dplx_blake2_impl_vtable_t const *vtable, int alg )
+{
+    switch (alg)
+    {
+        case DPLX_BLAKE2_ALGORITHM_B: return vtable->dplx_blake2b;
+        case DPLX_BLAKE2_ALGORITHM_S: return vtable->dplx_blake2s;
+        case DPLX_BLAKE2_ALGORITHM_BP: return vtable->dplx_blake2bp;
+        default: return vtable->dplx_blake2sp;
+    }
+}
+
+static double dplx_blake2_now( void )
+{
+    struct timespec ts;
+    if (timespec_get(&ts, TIME_UTC) != TIME_UTC)
+    {
+        return 0.0;
+    }
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// returns the best time out of three runs hashing 64 KiB in inlen sized messages
+static double dplx_blake2_measure( dplx_blake2_simple_fn_t fn, uint8_t *in, size_t inlen )
+{
+    size_t const reps = (64 * 1024) / inlen;
+    uint8_t out[32];
+    double best = 0.0;
+
+    for (int run = 0; run < 3; ++run)
+    {
+        double const start = dplx_blake2_now();
+        for (size_t i = 0; i < reps; ++i)
+        {
+            (void)fn(out, sizeof(out), in, inlen, NULL, 0);
+            in[0] ^= out[0]; // prevent the calls from being considered redundant
+        }
+        double const elapsed = dplx_blake2_now() - start;
+        if (run == 0 || elapsed < best)
+        {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+int dplx_blake2_autotune( void )
+{
+    static size_t const sample_lengths[DPLX_BLAKE2_SIZE_CLASS_COUNT] = {64, 2 * 1024, 64 * 1024};
+    size_t const max_length = sample_lengths[DPLX_BLAKE2_SIZE_CLASS_COUNT - 1];
+
+    uint8_t *const in = (uint8_t *)malloc(max_length);
+    if (in == NULL)
+    {
+        return -1;
+    }
+    for (size_t i = 0; i < max_length; ++i)
+    {
+        in[i] = (uint8_t)i;
+    }
+
+    unsigned const supported = dplx_blake2_supported_slots();
+    int const preferred = dplx_blake2_choose_impl();
+    dplx_blake2_selection_t selection;
+    for (int alg = 0; alg < DPLX_BLAKE2_ALGORITHM_COUNT; ++alg)
+    {
+        for (int size = 0; size < DPLX_BLAKE2_SIZE_CLASS_COUNT; ++size)
+        {
+            // another implementation needs to be at least 5% faster than the
+            // one chosen by feature detection in order to replace it
+            int best = preferred;
+            double bestTime = 0.95 * dplx_blake2_measure(
+                    dplx_blake2_simple_fn(&dplx_blake2_impl_vtables[preferred], alg), in, sample_lengths[size]);
+            for (int slot = 0; slot < DPLX_BLAKE2_IMPL_SLOT_COUNT; ++slot)
+            {
+                if (slot == preferred || !(supported & (1U << slot)))
+                {
+                    continue;
+                }
+                double const time = dplx_blake2_measure(
+                        dplx_blake2_simple_fn(&dplx_blake2_impl_vtables[slot], alg), in, sample_lengths[size]);
+                if (time < bestTime)
+                {
+                    best = slot;
+                    bestTime = time;
+                }
+            }
+            selection[alg][size] = &dplx_blake2_impl_vtables[best];
+        }
+    }
+    free(in);
+
+    dplx_blake2_install(selection);
+    return 0;
+}
+enum dplx_blake2_implementation_id dplx_blake2_tuned_implementation( enum dplx_blake2_algorithm alg, enum dplx_blake2_size_class size )
+{
+    if ((unsigned)alg >= DPLX_BLAKE2_ALGORITHM_COUNT || (unsigned)size >= DPLX_BLAKE2_SIZE_CLASS_COUNT)
+    {
+        return DPLX_BLAKE2_IMPL_COUNT;
+    }
+    dplx_blake2_impl_vtable_t const *const vtable = DPLX_BLAKE2_ATOMIC_PTR_LOAD_RELAXED(
+            dplx_blake2_impl_vtable_t const *, &dplx_blake2_selection[alg][size]);
+    return dplx_blake2_slot_to_impl(vtable != NULL
+            ? (enum dplx_blake2_implementation_slot)(vtable - dplx_blake2_impl_vtables)
+            : dplx_blake2_choose_impl());
+}
+
 int dplx_blake2_choose_implementation( void )
 {
-    return dplx_blake2_use_implementation(dplx_blake2_choose_impl());
+    dplx_blake2_use_slot(dplx_blake2_choose_impl());
+    return 0;
 }
 int dplx_blake2_use_implementation( enum dplx_blake2_implementation_id which )
 {
-    enum dplx_blake2_implementation_slot slot = dplx_blake2_impl_to_slot(which);
-    if (slot == DPLX_BLAKE2_IMPL_SLOT_INVALID)
+    if (!dplx_blake2_has_implementation(which))
     {
         return -1;
     }
 
-#define X_SET_IMPL(ret, name, params, args) DPLX_BLAKE2_ATOMIC_PTR_STORE_RELAXED(name##_fn_t, &name##_fn, dplx_blake2_impl_vtables[slot]. name );
-X_FOR_BLAKE2_API(X_SET_IMPL,)
-#undef X_SET_IMPL
-
+    dplx_blake2_use_slot(dplx_blake2_impl_to_slot(which));
     return 0;
 }
 bool dplx_blake2_has_implementation( enum dplx_blake2_implementation_id which )
 {
-    return dplx_blake2_impl_to_slot(which) != DPLX_BLAKE2_IMPL_SLOT_INVALID;
+    enum dplx_blake2_implementation_slot const slot = dplx_blake2_impl_to_slot(which);
+    return slot != DPLX_BLAKE2_IMPL_SLOT_INVALID
+        && (dplx_blake2_supported_slots() & (1U << slot)) != 0;
+}
+
+#endif
+
+enum dplx_blake2_implementation_id dplx_blake2_current_implementation( void )
+{
+    return dplx_blake2_tuned_implementation(DPLX_BLAKE2_ALGORITHM_B, DPLX_BLAKE2_SIZE_SMALL);
+}
+const char *dplx_blake2_implementation_name( enum dplx_blake2_implementation_id which )
+{
+    switch (which)
+    {
+        case DPLX_BLAKE2_IMPL_FALLBACK: return "fallback";
+#define X_MODE X_MODE_ALL
+#define X(l, u) case DPLX_BLAKE2_IMPL_ ## u: return #l;
+#include "blake2-impl-type.def"
+#undef X
+#undef X_MODE
+        default: return NULL;
+    }
+}
+enum dplx_blake2_implementation_id dplx_blake2_implementation_from_name( const char *name )
+{
+    if (name == NULL)
+    {
+        return DPLX_BLAKE2_IMPL_COUNT;
+    }
+    if (strcmp(name, "fallback") == 0)
+    {
+        return DPLX_BLAKE2_IMPL_FALLBACK;
+    }
+#define X_MODE X_MODE_ALL
+#define X(l, u) if (strcmp(name, #l) == 0) { return DPLX_BLAKE2_IMPL_ ## u; }
+#include "blake2-impl-type.def"
+#undef X
+#undef X_MODE
+    return DPLX_BLAKE2_IMPL_COUNT;
 }
@@ -0,0 +1,233 @@
+/*
+   Deeplex libb2 hash state serialization
+
+   Copyright 2026, Henrik S. Gaßmann <henrik@gassmann.onl>
+
+   You may use this under the terms of the CC0, the OpenSSL Licence, or the
+   Apache Public License 2.0, at your option. The terms of these licenses can be
+   found at:
+
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+   - OpenSSL license   : https://www.openssl.org/source/license.html
+   - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+
+   An exported state starts with the format version and an algorithm tag byte,
+   followed by the little endian state words and the buffer:
+
+     BLAKE2s/BLAKE2b    h[8], t[2], f[2], buflen, outlen, last_node, buf
+     BLAKE2Xs/BLAKE2Xb  the above, the parameter block, squeezed (64 bit)
+
+   buflen, outlen and last_node are single bytes. The whole block buffer is
+   always exported, i.e. the size is fixed for each algorithm.
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "dplx/blake2.h"
+#include "blake2-impl.h"
+
+enum blake2_state_tag
+{
+  BLAKE2_STATE_TAG_S  = 0x01,
+  BLAKE2_STATE_TAG_B  = 0x02,
+  BLAKE2_STATE_TAG_XS = 0x11,
+  BLAKE2_STATE_TAG_XB = 0x12,
+};
+
+#define BLAKE2_STATE_HEADERBYTES 2
+#define BLAKE2S_STATE_BODYBYTES ( 12 * 4 + 3 + DPLX_BLAKE2S_BLOCKBYTES )
+#define BLAKE2B_STATE_BODYBYTES ( 12 * 8 + 3 + DPLX_BLAKE2B_BLOCKBYTES )
+
+static_assert( DPLX_BLAKE2S_STATEBYTES == BLAKE2_STATE_HEADERBYTES + BLAKE2S_STATE_BODYBYTES, "BLAKE2s state format size mismatch" );
+static_assert( DPLX_BLAKE2B_STATEBYTES == BLAKE2_STATE_HEADERBYTES + BLAKE2B_STATE_BODYBYTES, "BLAKE2b state format size mismatch" );
+static_assert( DPLX_BLAKE2XS_STATEBYTES == DPLX_BLAKE2S_STATEBYTES + DPLX_BLAKE2S_OUTBYTES + 8, "BLAKE2Xs state format size mismatch" );
+static_assert( DPLX_BLAKE2XB_STATEBYTES == DPLX_BLAKE2B_STATEBYTES + DPLX_BLAKE2B_OUTBYTES + 8, "BLAKE2Xb state format size mismatch" );
+
+static void blake2_state_put_header( uint8_t *out, enum blake2_state_tag tag )
+{
+  out[0] = DPLX_BLAKE2_STATE_FORMAT_VERSION;
+  out[1] = (uint8_t)tag;
+}
+
+static int blake2_state_check_header( const uint8_t *in, enum blake2_state_tag tag )
+{
+  return in[0] == DPLX_BLAKE2_STATE_FORMAT_VERSION && in[1] == (uint8_t)tag ? 0 : -1;
+}
+
+static void blake2s_state_put( uint8_t *out, const dplx_blake2s_state *S )
+{
+  size_t i;
+
+  for( i = 0; i < 8; ++i )
+    store32( out + 4 * i, S->h[i] );
+  store32( out + 32, S->t[0] );
+  store32( out + 36, S->t[1] );
+  store32( out + 40, S->f[0] );
+  store32( out + 44, S->f[1] );
+  out[48] = (uint8_t)S->buflen;
+  out[49] = (uint8_t)S->outlen;
+  out[50] = S->last_node;
+  memcpy( out + 51, S->buf, DPLX_BLAKE2S_BLOCKBYTES );
+}
+
+static int blake2s_state_get( dplx_blake2s_state *S, const uint8_t *in )
+{
+  size_t i;
+
+  /* reject states which couldn't have been produced by the API */
+  if( in[48] > DPLX_BLAKE2S_BLOCKBYTES ) return -1;
+  if( in[49] == 0 || in[49] > DPLX_BLAKE2S_OUTBYTES ) return -1;
+  if( in[50] > 1 ) return -1;
+
+  for( i = 0; i < 8; ++i )
+    S->h[i] = load32( in + 4 * i );
+  S->t[0] = load32( in + 32 );
+  S->t[1] = load32( in + 36 );
+  S->f[0] = load32( in + 40 );
+  S->f[1] = load32( in + 44 );
+  S->buflen = in[48];
+  S->outlen = in[49];
+  S->last_node = in[50];
+  memcpy( S->buf, in + 51, DPLX_BLAKE2S_BLOCKBYTES );
+  return 0;
+}
+
+static void blake2b_state_put( uint8_t *out, const dplx_blake2b_state *S )
+{
+  size_t i;
+
+  for( i = 0; i < 8; ++i )
+    store64( out + 8 * i, S->h[i] );
+  store64( out + 64, S->t[0] );
+  store64( out + 72, S->t[1] );
+  store64( out + 80, S->f[0] );
+  store64( out + 88, S->f[1] );
+  out[96] = (uint8_t)S->buflen;
+  out[97] = (uint8_t)S->outlen;
+  out[98] = S->last_node;
+  memcpy( out + 99, S->buf, DPLX_BLAKE2B_BLOCKBYTES );
+}
+
+static int blake2b_state_get( dplx_blake2b_state *S, const uint8_t *in )
+{
+  size_t i;
+
+  /* reject states which couldn't have been produced by the API */
+  if( in[96] > DPLX_BLAKE2B_BLOCKBYTES ) return -1;
+  if( in[97] == 0 || in[97] > DPLX_BLAKE2B_OUTBYTES ) return -1;
+  if( in[98] > 1 ) return -1;
+
+  for( i = 0; i < 8; ++i )
+    S->h[i] = load64( in + 8 * i );
+  S->t[0] = load64( in + 64 );
+  S->t[1] = load64( in + 72 );
+  S->f[0] = load64( in + 80 );
+  S->f[1] = load64( in + 88 );
+  S->buflen = in[96];
+  S->outlen = in[97];
+  S->last_node = in[98];
+  memcpy( S->buf, in + 99, DPLX_BLAKE2B_BLOCKBYTES );
+  return 0;
+}
+
+int dplx_blake2s_state_export( const dplx_blake2s_state *S, void *out )
+{
+  uint8_t *p = (uint8_t *)out;
+
+  if( NULL == S || NULL == out ) return -1;
+
+  blake2_state_put_header( p, BLAKE2_STATE_TAG_S );
+  blake2s_state_put( p + BLAKE2_STATE_HEADERBYTES, S );
+  return 0;
+}
+
+int dplx_blake2s_state_import( dplx_blake2s_state *S, const void *in )
+{
+  const uint8_t *p = (const uint8_t *)in;
+
+  if( NULL == S || NULL == in ) return -1;
+
+  if( blake2_state_check_header( p, BLAKE2_STATE_TAG_S ) < 0 ) return -1;
+
+  return blake2s_state_get( S, p + BLAKE2_STATE_HEADERBYTES );
+}
+
+int dplx_blake2b_state_export( const dplx_blake2b_state *S, void *out )
+{
+  uint8_t *p = (uint8_t *)out;
+
+  if( NULL == S || NULL == out ) return -1;
+
+  blake2_state_put_header( p, BLAKE2_STATE_TAG_B );
+  blake2b_state_put( p + BLAKE2_STATE_HEADERBYTES, S );
+  return 0;
+}
+
+int dplx_blake2b_state_import( dplx_blake2b_state *S, const void *in )
+{
+  const uint8_t *p = (const uint8_t *)in;
+
+  if( NULL == S || NULL == in ) return -1;
+
+  if( blake2_state_check_header( p, BLAKE2_STATE_TAG_B ) < 0 ) return -1;
+
+  return blake2b_state_get( S, p + BLAKE2_STATE_HEADERBYTES );
+}
+
+/* the parameter block is stored in its little endian wire format */
+int dplx_blake2xs_state_export( const dplx_blake2xs_state *S, void *out )
+{
+  uint8_t *p = (uint8_t *)out;
+
+  if( NULL == S || NULL == out ) return -1;
+
+  blake2_state_put_header( p, BLAKE2_STATE_TAG_XS );
+  blake2s_state_put( p + BLAKE2_STATE_HEADERBYTES, S->S );
+  memcpy( p + DPLX_BLAKE2S_STATEBYTES, S->P, sizeof( S->P ) );
+  store64( p + DPLX_BLAKE2S_STATEBYTES + sizeof( S->P ), S->squeezed );
+  return 0;
+}
+
+int dplx_blake2xs_state_import( dplx_blake2xs_state *S, const void *in )
+{
+  const uint8_t *p = (const uint8_t *)in;
+
+  if( NULL == S || NULL == in ) return -1;
+
+  if( blake2_state_check_header( p, BLAKE2_STATE_TAG_XS ) < 0 ) return -1;
+
+  if( blake2s_state_get( S->S, p + BLAKE2_STATE_HEADERBYTES ) < 0 ) return -1;
+
+  memcpy( S->P, p + DPLX_BLAKE2S_STATEBYTES, sizeof( S->P ) );
+  S->squeezed = load64( p + DPLX_BLAKE2S_STATEBYTES + sizeof( S->P ) );
+  return 0;
+}
+
+int dplx_blake2xb_state_export( const dplx_blake2xb_state *S, void *out )
+{
+  uint8_t *p = (uint8_t *)out;
+
+  if( NULL == S || NULL == out ) return -1;
+
+  blake2_state_put_header( p, BLAKE2_STATE_TAG_XB );
+  blake2b_state_put( p + BLAKE2_STATE_HEADERBYTES, S->S );
+  memcpy( p + DPLX_BLAKE2B_STATEBYTES, S->P, sizeof( S->P ) );
+  store64( p + DPLX_BLAKE2B_STATEBYTES + sizeof( S->P ), S->squeezed );
+  return 0;
+}
+
+int dplx_blake2xb_state_import( dplx_blake2xb_state *S, const void *in )
+{
+  const uint8_t *p = (const uint8_t *)in;
+
+  if( NULL == S || NULL == in ) return -1;
+
+  if( blake2_state_check_header( p, BLAKE2_STATE_TAG_XB ) < 0 ) return -1;
+
+  if( blake2b_state_get( S->S, p + BLAKE2_STATE_HEADERBYTES ) < 0 ) return -1;
+
+  memcpy( S->P, p + DPLX_BLAKE2B_STATEBYTES, sizeof( S->P ) );
+  S->squeezed = load64( p + DPLX_BLAKE2B_STATEBYTES + sizeof( S->P ) );
+  return 0;
+}
@@ -32,11 +32,25 @@
 #define HAVE_AVX
 #endif
 
+#if defined(__AVX2__)
+#define HAVE_AVX2
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512VL__)
+#define HAVE_AVX512VL
+#endif
+
 #if defined(__XOP__)
 #define HAVE_XOP
 #endif
 
 
+#ifdef HAVE_AVX512VL
+#ifndef HAVE_AVX2
+#define HAVE_AVX2
+#endif
+#endif
+
 #ifdef HAVE_AVX2
 #ifndef HAVE_AVX
 #define HAVE_AVX
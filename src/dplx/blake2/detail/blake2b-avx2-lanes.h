@@ -0,0 +1,65 @@
+/*
+   Deeplex libb2 multi-lane BLAKE2b round macros (AVX2)
+
+   Copyright 2026, Henrik S. Gaßmann <henrik@gassmann.onl>
+
+   You may use this under the terms of the CC0, the OpenSSL Licence, or the
+   Apache Public License 2.0, at your option. The terms of these licenses can be
+   found at:
+
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+   - OpenSSL license   : https://www.openssl.org/source/license.html
+   - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+*/
+#ifndef BLAKE2B_AVX2_LANES_H
+#define BLAKE2B_AVX2_LANES_H
+
+/* Each ymm register holds the same state word of all four lanes, i.e. the
+   vertical layout of blake2b-x86-lanes.h at twice the width. Relies on
+   _mm256_roti_epi64 from blake2b-avx2-round.h. */
+
+#define LANES_G(a,b,c,d,x,y) \
+  a = _mm256_add_epi64(_mm256_add_epi64(a, b), x); \
+  d = _mm256_xor_si256(d, a); \
+  d = _mm256_roti_epi64(d, -32); \
+  c = _mm256_add_epi64(c, d); \
+  b = _mm256_xor_si256(b, c); \
+  b = _mm256_roti_epi64(b, -24); \
+  a = _mm256_add_epi64(_mm256_add_epi64(a, b), y); \
+  d = _mm256_xor_si256(d, a); \
+  d = _mm256_roti_epi64(d, -16); \
+  c = _mm256_add_epi64(c, d); \
+  b = _mm256_xor_si256(b, c); \
+  b = _mm256_roti_epi64(b, -63);
+
+#define LANES_ROUND(r) \
+  LANES_G(v[ 0],v[ 4],v[ 8],v[12],m[blake2b_sigma[r][ 0]],m[blake2b_sigma[r][ 1]]); \
+  LANES_G(v[ 1],v[ 5],v[ 9],v[13],m[blake2b_sigma[r][ 2]],m[blake2b_sigma[r][ 3]]); \
+  LANES_G(v[ 2],v[ 6],v[10],v[14],m[blake2b_sigma[r][ 4]],m[blake2b_sigma[r][ 5]]); \
+  LANES_G(v[ 3],v[ 7],v[11],v[15],m[blake2b_sigma[r][ 6]],m[blake2b_sigma[r][ 7]]); \
+  LANES_G(v[ 0],v[ 5],v[10],v[15],m[blake2b_sigma[r][ 8]],m[blake2b_sigma[r][ 9]]); \
+  LANES_G(v[ 1],v[ 6],v[11],v[12],m[blake2b_sigma[r][10]],m[blake2b_sigma[r][11]]); \
+  LANES_G(v[ 2],v[ 7],v[ 8],v[13],m[blake2b_sigma[r][12]],m[blake2b_sigma[r][13]]); \
+  LANES_G(v[ 3],v[ 4],v[ 9],v[14],m[blake2b_sigma[r][14]],m[blake2b_sigma[r][15]]);
+
+/* transposes the message blocks of four lanes into vertical layout */
+#define LANES_LOAD_MSG(m, block0, block1, block2, block3) \
+  for( j = 0; j < 4; ++j ) \
+  { \
+    const __m256i b0 = LOADU256( (block0) + 32 * j ); \
+    const __m256i b1 = LOADU256( (block1) + 32 * j ); \
+    const __m256i b2 = LOADU256( (block2) + 32 * j ); \
+    const __m256i b3 = LOADU256( (block3) + 32 * j ); \
+    const __m256i t0 = _mm256_unpacklo_epi64( b0, b1 ); \
+    const __m256i t1 = _mm256_unpackhi_epi64( b0, b1 ); \
+    const __m256i t2 = _mm256_unpacklo_epi64( b2, b3 ); \
+    const __m256i t3 = _mm256_unpackhi_epi64( b2, b3 ); \
+    m[4 * j + 0] = _mm256_permute2x128_si256( t0, t2, 0x20 ); \
+    m[4 * j + 1] = _mm256_permute2x128_si256( t1, t3, 0x20 ); \
+    m[4 * j + 2] = _mm256_permute2x128_si256( t0, t2, 0x31 ); \
+    m[4 * j + 3] = _mm256_permute2x128_si256( t1, t3, 0x31 ); \
+  }
+
+#define LANES_SET1(w) _mm256_set1_epi64x( (long long)(w) )
+
+#endif
@@ -0,0 +1,80 @@
+/*
+   Deeplex libb2 BLAKE2b AVX2 round macros
+
+   Copyright 2026, Henrik S. Gaßmann <henrik@gassmann.onl>
+
+   You may use this under the terms of the CC0, the OpenSSL Licence, or the
+   Apache Public License 2.0, at your option. The terms of these licenses can be
+   found at:
+
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+   - OpenSSL license   : https://www.openssl.org/source/license.html
+   - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+*/
+#ifndef BLAKE2B_AVX2_ROUND_H
+#define BLAKE2B_AVX2_ROUND_H
+
+#define LOADU(p)  _mm_loadu_si128( (const __m128i *)(p) )
+#define STOREU(p,r) _mm_storeu_si128((__m128i *)(p), r)
+#define LOADU256(p)  _mm256_loadu_si256( (const __m256i *)(p) )
+#define STOREU256(p,r) _mm256_storeu_si256((__m256i *)(p), r)
+#define BROADCASTU128(p) _mm256_broadcastsi128_si256( LOADU( p ) )
+
+/* Microarchitecture-specific macros */
+#if defined(HAVE_AVX512VL)
+#define _mm256_roti_epi64(x, c) _mm256_ror_epi64((x), -(c))
+#define _mm256_xor3_si256(a, b, c) _mm256_ternarylogic_epi64((a), (b), (c), 0x96)
+#else
+#define _mm256_roti_epi64(x, c) \
+    (-(c) == 32) ? _mm256_shuffle_epi32((x), _MM_SHUFFLE(2,3,0,1))  \
+    : (-(c) == 24) ? _mm256_shuffle_epi8((x), r24) \
+    : (-(c) == 16) ? _mm256_shuffle_epi8((x), r16) \
+    : (-(c) == 63) ? _mm256_xor_si256(_mm256_srli_epi64((x), -(c)), _mm256_add_epi64((x), (x)))  \
+    : _mm256_xor_si256(_mm256_srli_epi64((x), -(c)), _mm256_slli_epi64((x), 64-(-(c))))
+#define _mm256_xor3_si256(a, b, c) _mm256_xor_si256((a), _mm256_xor_si256((b), (c)))
+#endif
+
+/* Each row of the 4x4 state matrix lives in a single ymm register. With
+   AVX-512VL the rotations map to vprorq and three-way xors to vpternlogq. */
+
+#define G1(row1,row2,row3,row4,b0) \
+  row1 = _mm256_add_epi64(_mm256_add_epi64(row1, b0), row2); \
+  row4 = _mm256_xor_si256(row4, row1); \
+  row4 = _mm256_roti_epi64(row4, -32); \
+  row3 = _mm256_add_epi64(row3, row4); \
+  row2 = _mm256_xor_si256(row2, row3); \
+  row2 = _mm256_roti_epi64(row2, -24);
+
+#define G2(row1,row2,row3,row4,b0) \
+  row1 = _mm256_add_epi64(_mm256_add_epi64(row1, b0), row2); \
+  row4 = _mm256_xor_si256(row4, row1); \
+  row4 = _mm256_roti_epi64(row4, -16); \
+  row3 = _mm256_add_epi64(row3, row4); \
+  row2 = _mm256_xor_si256(row2, row3); \
+  row2 = _mm256_roti_epi64(row2, -63);
+
+#define DIAGONALIZE(row1,row2,row3,row4) \
+  row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(0,3,2,1)); \
+  row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1,0,3,2)); \
+  row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(2,1,0,3));
+
+#define UNDIAGONALIZE(row1,row2,row3,row4) \
+  row2 = _mm256_permute4x64_epi64(row2, _MM_SHUFFLE(2,1,0,3)); \
+  row3 = _mm256_permute4x64_epi64(row3, _MM_SHUFFLE(1,0,3,2)); \
+  row4 = _mm256_permute4x64_epi64(row4, _MM_SHUFFLE(0,3,2,1));
+
+#include "blake2b-avx2-load.h"
+
+#define ROUND(r) \
+  LOAD_MSG_ ##r ##_1(b0); \
+  G1(row1,row2,row3,row4,b0); \
+  LOAD_MSG_ ##r ##_2(b0); \
+  G2(row1,row2,row3,row4,b0); \
+  DIAGONALIZE(row1,row2,row3,row4); \
+  LOAD_MSG_ ##r ##_3(b0); \
+  G1(row1,row2,row3,row4,b0); \
+  LOAD_MSG_ ##r ##_4(b0); \
+  G2(row1,row2,row3,row4,b0); \
+  UNDIAGONALIZE(row1,row2,row3,row4);
+
+#endif
@@ -0,0 +1,116 @@
+/*
+   Deeplex libb2 BLAKE2b AVX2 implementation
+
+   Copyright 2026, Henrik S. Gaßmann <henrik@gassmann.onl>
+
+   You may use this under the terms of the CC0, the OpenSSL Licence, or the
+   Apache Public License 2.0, at your option. The terms of these licenses can be
+   found at:
+
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+   - OpenSSL license   : https://www.openssl.org/source/license.html
+   - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+*/
+
+#include <stdint.h>
+
+#include "blake2.h"
+#include "blake2-impl.h"
+
+#include "blake2b-common.c.inc"
+#include "blake2bp-common.c.inc"
+#include "blake2b-many.c.inc"
+#include "blake2xb-common.c.inc"
+
+#include "blake2-x86-config.h"
+
+#if !defined(HAVE_AVX2)
+#error "This code requires AVX2."
+#endif
+
+#include <immintrin.h>
+
+#include "blake2b-avx2-round.h"
+#include "blake2b-avx2-lanes.h"
+
+static void blake2b_compress( blake2b_state *S, const uint8_t block[BLAKE2B_BLOCKBYTES] )
+{
+  __m256i row1, row2, row3, row4;
+  __m256i b0;
+  __m256i t0, t1;
+#if !defined(HAVE_AVX512VL)
+  const __m256i r16 = _mm256_setr_epi8( 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+                                        2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9 );
+  const __m256i r24 = _mm256_setr_epi8( 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                        3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10 );
+#endif
+  const __m256i m0 = BROADCASTU128( block + 00 );
+  const __m256i m1 = BROADCASTU128( block + 16 );
+  const __m256i m2 = BROADCASTU128( block + 32 );
+  const __m256i m3 = BROADCASTU128( block + 48 );
+  const __m256i m4 = BROADCASTU128( block + 64 );
+  const __m256i m5 = BROADCASTU128( block + 80 );
+  const __m256i m6 = BROADCASTU128( block + 96 );
+  const __m256i m7 = BROADCASTU128( block + 112 );
+
+  row1 = LOADU256( &S->h[0] );
+  row2 = LOADU256( &S->h[4] );
+  row3 = LOADU256( &blake2b_IV[0] );
+  row4 = _mm256_xor_si256( LOADU256( &blake2b_IV[4] ),
+                           _mm256_inserti128_si256( _mm256_castsi128_si256( LOADU( &S->t[0] ) ), LOADU( &S->f[0] ), 1 ) );
+  ROUND( 0 );
+  ROUND( 1 );
+  ROUND( 2 );
+  ROUND( 3 );
+  ROUND( 4 );
+  ROUND( 5 );
+  ROUND( 6 );
+  ROUND( 7 );
+  ROUND( 8 );
+  ROUND( 9 );
+  ROUND( 10 );
+  ROUND( 11 );
+  STOREU256( &S->h[0], _mm256_xor3_si256( LOADU256( &S->h[0] ), row1, row3 ) );
+  STOREU256( &S->h[4], _mm256_xor3_si256( LOADU256( &S->h[4] ), row2, row4 ) );
+}
+
+static_assert(BLAKE2B_LANES == 4, "the AVX2 lane kernel processes all lanes in one pass");
+
+static void blake2b_compress_lanes( blake2b_lanes *L, const uint8_t *const blocks[BLAKE2B_LANES] )
+{
+#if !defined(HAVE_AVX512VL)
+  const __m256i r16 = _mm256_setr_epi8( 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+                                        2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9 );
+  const __m256i r24 = _mm256_setr_epi8( 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                        3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10 );
+#endif
+  __m256i m[16];
+  __m256i v[16];
+  size_t j;
+
+  LANES_LOAD_MSG( m, blocks[0], blocks[1], blocks[2], blocks[3] );
+  for( j = 0; j < 8; ++j )
+    v[j] = LOADU256( &L->h[j][0] );
+  v[ 8] = LANES_SET1( blake2b_IV[0] );
+  v[ 9] = LANES_SET1( blake2b_IV[1] );
+  v[10] = LANES_SET1( blake2b_IV[2] );
+  v[11] = LANES_SET1( blake2b_IV[3] );
+  v[12] = _mm256_xor_si256( LANES_SET1( blake2b_IV[4] ), LOADU256( &L->t[0][0] ) );
+  v[13] = _mm256_xor_si256( LANES_SET1( blake2b_IV[5] ), LOADU256( &L->t[1][0] ) );
+  v[14] = _mm256_xor_si256( LANES_SET1( blake2b_IV[6] ), LOADU256( &L->f[0][0] ) );
+  v[15] = _mm256_xor_si256( LANES_SET1( blake2b_IV[7] ), LOADU256( &L->f[1][0] ) );
+  LANES_ROUND( 0 );
+  LANES_ROUND( 1 );
+  LANES_ROUND( 2 );
+  LANES_ROUND( 3 );
+  LANES_ROUND( 4 );
+  LANES_ROUND( 5 );
+  LANES_ROUND( 6 );
+  LANES_ROUND( 7 );
+  LANES_ROUND( 8 );
+  LANES_ROUND( 9 );
+  LANES_ROUND( 10 );
+  LANES_ROUND( 11 );
+  for( j = 0; j < 8; ++j )
+    STOREU256( &L->h[j][0], _mm256_xor3_si256( LOADU256( &L->h[j][0] ), v[j], v[j + 8] ) );
+}
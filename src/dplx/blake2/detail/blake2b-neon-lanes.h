@@ -0,0 +1,51 @@
+/*
+   Deeplex libb2 multi-lane BLAKE2b round macros (NEON)
+
+   Copyright 2026, Henrik S. Gaßmann <henrik@gassmann.onl>
+
+   You may use this under the terms of the CC0, the OpenSSL Licence, or the
+   Apache Public License 2.0, at your option. The terms of these licenses can be
+   found at:
+
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+   - OpenSSL license   : https://www.openssl.org/source/license.html
+   - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+*/
+#ifndef BLAKE2B_LANES_H
+#define BLAKE2B_LANES_H
+
+/* Each register holds the same state word of two independent BLAKE2b
+   instances (lane interleaved / vertical layout), therefore no diagonalization
+   is required. Relies on the vrorq_n_u64_* macros from blake2b-neon-round.h. */
+
+#define LANES_G(a,b,c,d,x,y) \
+  a = vaddq_u64(vaddq_u64(a, b), x); \
+  d = vrorq_n_u64_32(veorq_u64(d, a)); \
+  c = vaddq_u64(c, d); \
+  b = vrorq_n_u64_24(veorq_u64(b, c)); \
+  a = vaddq_u64(vaddq_u64(a, b), y); \
+  d = vrorq_n_u64_16(veorq_u64(d, a)); \
+  c = vaddq_u64(c, d); \
+  b = vrorq_n_u64_63(veorq_u64(b, c));
+
+#define LANES_ROUND(r) \
+  LANES_G(v[ 0],v[ 4],v[ 8],v[12],m[blake2b_sigma[r][ 0]],m[blake2b_sigma[r][ 1]]); \
+  LANES_G(v[ 1],v[ 5],v[ 9],v[13],m[blake2b_sigma[r][ 2]],m[blake2b_sigma[r][ 3]]); \
+  LANES_G(v[ 2],v[ 6],v[10],v[14],m[blake2b_sigma[r][ 4]],m[blake2b_sigma[r][ 5]]); \
+  LANES_G(v[ 3],v[ 7],v[11],v[15],m[blake2b_sigma[r][ 6]],m[blake2b_sigma[r][ 7]]); \
+  LANES_G(v[ 0],v[ 5],v[10],v[15],m[blake2b_sigma[r][ 8]],m[blake2b_sigma[r][ 9]]); \
+  LANES_G(v[ 1],v[ 6],v[11],v[12],m[blake2b_sigma[r][10]],m[blake2b_sigma[r][11]]); \
+  LANES_G(v[ 2],v[ 7],v[ 8],v[13],m[blake2b_sigma[r][12]],m[blake2b_sigma[r][13]]); \
+  LANES_G(v[ 3],v[ 4],v[ 9],v[14],m[blake2b_sigma[r][14]],m[blake2b_sigma[r][15]]);
+
+/* transposes the message blocks of two lanes into vertical layout */
+#define LANES_LOAD_MSG(m, block0, block1) \
+  for( j = 0; j < 8; ++j ) \
+  { \
+    const uint64x2_t b0 = vreinterpretq_u64_u8( vld1q_u8( (block0) + 16 * j ) ); \
+    const uint64x2_t b1 = vreinterpretq_u64_u8( vld1q_u8( (block1) + 16 * j ) ); \
+    m[2 * j + 0] = vcombine_u64( vget_low_u64( b0 ), vget_low_u64( b1 ) ); \
+    m[2 * j + 1] = vcombine_u64( vget_high_u64( b0 ), vget_high_u64( b1 ) ); \
+  }
+
+#endif
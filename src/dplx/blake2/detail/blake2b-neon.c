@@ -20,8 +20,12 @@
 #include "blake2-impl.h"
 
 #include "blake2b-common.c.inc"
+#include "blake2bp-common.c.inc"
+#include "blake2b-many.c.inc"
+#include "blake2xb-common.c.inc"
 
 #include "blake2b-neon-round.h"
+#include "blake2b-neon-lanes.h"
 
 static void blake2b_compress( blake2b_state *S, const uint8_t block[BLAKE2B_BLOCKBYTES] )
 {
@@ -66,3 +70,39 @@ static void blake2b_compress( blake2b_state *S, const uint8_t block[BLAKE2B_BLOC
   vst1q_u64(&S->h[4], veorq_u64(h2, veorq_u64(row2l, row4l)));
   vst1q_u64(&S->h[6], veorq_u64(h3, veorq_u64(row2h, row4h)));
 }
+
+static void blake2b_compress_lanes( blake2b_lanes *L, const uint8_t *const blocks[BLAKE2B_LANES] )
+{
+  uint64x2_t m[16];
+  uint64x2_t v[16];
+  size_t i, j;
+
+  for( i = 0; i < BLAKE2B_LANES; i += 2 )
+  {
+    LANES_LOAD_MSG( m, blocks[i], blocks[i + 1] );
+    for( j = 0; j < 8; ++j )
+      v[j] = vld1q_u64( &L->h[j][i] );
+    v[ 8] = vdupq_n_u64( blake2b_IV[0] );
+    v[ 9] = vdupq_n_u64( blake2b_IV[1] );
+    v[10] = vdupq_n_u64( blake2b_IV[2] );
+    v[11] = vdupq_n_u64( blake2b_IV[3] );
+    v[12] = veorq_u64( vdupq_n_u64( blake2b_IV[4] ), vld1q_u64( &L->t[0][i] ) );
+    v[13] = veorq_u64( vdupq_n_u64( blake2b_IV[5] ), vld1q_u64( &L->t[1][i] ) );
+    v[14] = veorq_u64( vdupq_n_u64( blake2b_IV[6] ), vld1q_u64( &L->f[0][i] ) );
+    v[15] = veorq_u64( vdupq_n_u64( blake2b_IV[7] ), vld1q_u64( &L->f[1][i] ) );
+    LANES_ROUND( 0 );
+    LANES_ROUND( 1 );
+    LANES_ROUND( 2 );
+    LANES_ROUND( 3 );
+    LANES_ROUND( 4 );
+    LANES_ROUND( 5 );
+    LANES_ROUND( 6 );
+    LANES_ROUND( 7 );
+    LANES_ROUND( 8 );
+    LANES_ROUND( 9 );
+    LANES_ROUND( 10 );
+    LANES_ROUND( 11 );
+    for( j = 0; j < 8; ++j )
+      vst1q_u64( &L->h[j][i], veorq_u64( vld1q_u64( &L->h[j][i] ), veorq_u64( v[j], v[j + 8] ) ) );
+  }
+}
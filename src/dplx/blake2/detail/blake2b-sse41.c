@@ -21,6 +21,9 @@
 #include "blake2-impl.h"
 
 #include "blake2b-common.c.inc"
+#include "blake2bp-common.c.inc"
+#include "blake2b-many.c.inc"
+#include "blake2xb-common.c.inc"
 
 #include "blake2-x86-config.h"
 
@@ -42,6 +45,7 @@
 #endif
 
 #include "blake2b-x86-round.h"
+#include "blake2b-x86-lanes.h"
 
 static void blake2b_compress( blake2b_state *S, const uint8_t block[BLAKE2B_BLOCKBYTES] )
 {
@@ -111,3 +115,43 @@ static void blake2b_compress( blake2b_state *S, const uint8_t block[BLAKE2B_BLOC
   STOREU( &S->h[4], _mm_xor_si128( LOADU( &S->h[4] ), row2l ) );
   STOREU( &S->h[6], _mm_xor_si128( LOADU( &S->h[6] ), row2h ) );
 }
+
+static void blake2b_compress_lanes( blake2b_lanes *L, const uint8_t *const blocks[BLAKE2B_LANES] )
+{
+#if defined(HAVE_SSSE3) && !defined(HAVE_XOP)
+  const __m128i r16 = _mm_setr_epi8( 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9 );
+  const __m128i r24 = _mm_setr_epi8( 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10 );
+#endif
+  __m128i m[16];
+  __m128i v[16];
+  size_t i, j;
+
+  for( i = 0; i < BLAKE2B_LANES; i += 2 )
+  {
+    LANES_LOAD_MSG( m, blocks[i], blocks[i + 1] );
+    for( j = 0; j < 8; ++j )
+      v[j] = LOADU( &L->h[j][i] );
+    v[ 8] = LANES_SET1( blake2b_IV[0] );
+    v[ 9] = LANES_SET1( blake2b_IV[1] );
+    v[10] = LANES_SET1( blake2b_IV[2] );
+    v[11] = LANES_SET1( blake2b_IV[3] );
+    v[12] = _mm_xor_si128( LANES_SET1( blake2b_IV[4] ), LOADU( &L->t[0][i] ) );
+    v[13] = _mm_xor_si128( LANES_SET1( blake2b_IV[5] ), LOADU( &L->t[1][i] ) );
+    v[14] = _mm_xor_si128( LANES_SET1( blake2b_IV[6] ), LOADU( &L->f[0][i] ) );
+    v[15] = _mm_xor_si128( LANES_SET1( blake2b_IV[7] ), LOADU( &L->f[1][i] ) );
+    LANES_ROUND( 0 );
+    LANES_ROUND( 1 );
+    LANES_ROUND( 2 );
+    LANES_ROUND( 3 );
+    LANES_ROUND( 4 );
+    LANES_ROUND( 5 );
+    LANES_ROUND( 6 );
+    LANES_ROUND( 7 );
+    LANES_ROUND( 8 );
+    LANES_ROUND( 9 );
+    LANES_ROUND( 10 );
+    LANES_ROUND( 11 );
+    for( j = 0; j < 8; ++j )
+      STOREU( &L->h[j][i], _mm_xor_si128( LOADU( &L->h[j][i] ), _mm_xor_si128( v[j], v[j + 8] ) ) );
+  }
+}
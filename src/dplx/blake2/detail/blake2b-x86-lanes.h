@@ -0,0 +1,57 @@
+/*
+   Deeplex libb2 multi-lane BLAKE2b round macros (SSE2 / SSSE3 / SSE4.1 / AVX)
+
+   Copyright 2026, Henrik S. Gaßmann <henrik@gassmann.onl>
+
+   You may use this under the terms of the CC0, the OpenSSL Licence, or the
+   Apache Public License 2.0, at your option. The terms of these licenses can be
+   found at:
+
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+   - OpenSSL license   : https://www.openssl.org/source/license.html
+   - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+*/
+#ifndef BLAKE2B_LANES_H
+#define BLAKE2B_LANES_H
+
+/* Each register holds the same state word of two independent BLAKE2b
+   instances (lane interleaved / vertical layout), therefore no diagonalization
+   is required. Relies on _mm_roti_epi64 from blake2b-x86-round.h. */
+
+#define LANES_G(a,b,c,d,x,y) \
+  a = _mm_add_epi64(_mm_add_epi64(a, b), x); \
+  d = _mm_xor_si128(d, a); \
+  d = _mm_roti_epi64(d, -32); \
+  c = _mm_add_epi64(c, d); \
+  b = _mm_xor_si128(b, c); \
+  b = _mm_roti_epi64(b, -24); \
+  a = _mm_add_epi64(_mm_add_epi64(a, b), y); \
+  d = _mm_xor_si128(d, a); \
+  d = _mm_roti_epi64(d, -16); \
+  c = _mm_add_epi64(c, d); \
+  b = _mm_xor_si128(b, c); \
+  b = _mm_roti_epi64(b, -63);
+
+#define LANES_ROUND(r) \
+  LANES_G(v[ 0],v[ 4],v[ 8],v[12],m[blake2b_sigma[r][ 0]],m[blake2b_sigma[r][ 1]]); \
+  LANES_G(v[ 1],v[ 5],v[ 9],v[13],m[blake2b_sigma[r][ 2]],m[blake2b_sigma[r][ 3]]); \
+  LANES_G(v[ 2],v[ 6],v[10],v[14],m[blake2b_sigma[r][ 4]],m[blake2b_sigma[r][ 5]]); \
+  LANES_G(v[ 3],v[ 7],v[11],v[15],m[blake2b_sigma[r][ 6]],m[blake2b_sigma[r][ 7]]); \
+  LANES_G(v[ 0],v[ 5],v[10],v[15],m[blake2b_sigma[r][ 8]],m[blake2b_sigma[r][ 9]]); \
+  LANES_G(v[ 1],v[ 6],v[11],v[12],m[blake2b_sigma[r][10]],m[blake2b_sigma[r][11]]); \
+  LANES_G(v[ 2],v[ 7],v[ 8],v[13],m[blake2b_sigma[r][12]],m[blake2b_sigma[r][13]]); \
+  LANES_G(v[ 3],v[ 4],v[ 9],v[14],m[blake2b_sigma[r][14]],m[blake2b_sigma[r][15]]);
+
+/* transposes the message blocks of two lanes into vertical layout */
+#define LANES_LOAD_MSG(m, block0, block1) \
+  for( j = 0; j < 8; ++j ) \
+  { \
+    const __m128i b0 = LOADU( (block0) + 16 * j ); \
+    const __m128i b1 = LOADU( (block1) + 16 * j ); \
+    m[2 * j + 0] = _mm_unpacklo_epi64( b0, b1 ); \
+    m[2 * j + 1] = _mm_unpackhi_epi64( b0, b1 ); \
+  }
+
+#define LANES_SET1(w) _mm_set1_epi64x( (long long)(w) )
+
+#endif
@@ -19,6 +19,9 @@
 #include "blake2-impl.h"
 
 #include "blake2s-common.c.inc"
+#include "blake2sp-common.c.inc"
+#include "blake2s-many.c.inc"
+#include "blake2xs-common.c.inc"
 
 #include "blake2-x86-config.h"
 
@@ -37,16 +40,14 @@
 #endif
 
 #include "blake2s-x86-round.h"
+#include "blake2s-x86-lanes.h"
 
 static void blake2s_compress( blake2s_state *S, const uint8_t block[BLAKE2S_BLOCKBYTES] )
 {
   __m128i row1, row2, row3, row4;
   __m128i buf1, buf2, buf3, buf4;
 #if defined(HAVE_SSE41)
-  __m128i t0, t1;
-#if !defined(HAVE_XOP)
-  __m128i t2;
-#endif
+  __m128i t0, t1, t2;
 #endif
   __m128i ff0, ff1;
 #if defined(HAVE_SSSE3) && !defined(HAVE_XOP)
@@ -93,3 +94,41 @@ static void blake2s_compress( blake2s_state *S, const uint8_t block[BLAKE2S_BLOC
   STOREU( &S->h[0], _mm_xor_si128( ff0, _mm_xor_si128( row1, row3 ) ) );
   STOREU( &S->h[4], _mm_xor_si128( ff1, _mm_xor_si128( row2, row4 ) ) );
 }
+
+static void blake2s_compress_lanes( blake2s_lanes *L, const uint8_t *const blocks[BLAKE2S_LANES] )
+{
+#if defined(HAVE_SSSE3) && !defined(HAVE_XOP)
+  const __m128i r8 = _mm_set_epi8( 12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1 );
+  const __m128i r16 = _mm_set_epi8( 13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2 );
+#endif
+  __m128i m[16];
+  __m128i v[16];
+  size_t i, j;
+
+  for( i = 0; i < BLAKE2S_LANES; i += 4 )
+  {
+    LANES_LOAD_MSG( m, blocks[i], blocks[i + 1], blocks[i + 2], blocks[i + 3] );
+    for( j = 0; j < 8; ++j )
+      v[j] = LOADU( &L->h[j][i] );
+    v[ 8] = LANES_SET1( blake2s_IV[0] );
+    v[ 9] = LANES_SET1( blake2s_IV[1] );
+    v[10] = LANES_SET1( blake2s_IV[2] );
+    v[11] = LANES_SET1( blake2s_IV[3] );
+    v[12] = _mm_xor_si128( LANES_SET1( blake2s_IV[4] ), LOADU( &L->t[0][i] ) );
+    v[13] = _mm_xor_si128( LANES_SET1( blake2s_IV[5] ), LOADU( &L->t[1][i] ) );
+    v[14] = _mm_xor_si128( LANES_SET1( blake2s_IV[6] ), LOADU( &L->f[0][i] ) );
+    v[15] = _mm_xor_si128( LANES_SET1( blake2s_IV[7] ), LOADU( &L->f[1][i] ) );
+    LANES_ROUND( 0 );
+    LANES_ROUND( 1 );
+    LANES_ROUND( 2 );
+    LANES_ROUND( 3 );
+    LANES_ROUND( 4 );
+    LANES_ROUND( 5 );
+    LANES_ROUND( 6 );
+    LANES_ROUND( 7 );
+    LANES_ROUND( 8 );
+    LANES_ROUND( 9 );
+    for( j = 0; j < 8; ++j )
+      STOREU( &L->h[j][i], _mm_xor_si128( LOADU( &L->h[j][i] ), _mm_xor_si128( v[j], v[j + 8] ) ) );
+  }
+}
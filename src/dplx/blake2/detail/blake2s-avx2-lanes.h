@@ -0,0 +1,91 @@
+/*
+   Deeplex libb2 multi-lane BLAKE2s round macros (AVX2)
+
+   Copyright 2026, Henrik S. Gaßmann <henrik@gassmann.onl>
+
+   You may use this under the terms of the CC0, the OpenSSL Licence, or the
+   Apache Public License 2.0, at your option. The terms of these licenses can be
+   found at:
+
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+   - OpenSSL license   : https://www.openssl.org/source/license.html
+   - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+*/
+#ifndef BLAKE2S_AVX2_LANES_H
+#define BLAKE2S_AVX2_LANES_H
+
+/* Each ymm register holds the same state word of all eight lanes, i.e. the
+   vertical layout of blake2s-x86-lanes.h at twice the width. With AVX-512VL
+   the rotations map to vprord and three-way xors to vpternlogd. */
+
+#define LOADU256(p)  _mm256_loadu_si256( (const __m256i *)(p) )
+#define STOREU256(p,r) _mm256_storeu_si256((__m256i *)(p), r)
+
+#if defined(HAVE_AVX512VL)
+#define _mm256_roti_epi32(r, c) _mm256_ror_epi32((r), -(c))
+#define _mm256_xor3_si256(a, b, c) _mm256_ternarylogic_epi32((a), (b), (c), 0x96)
+#else
+#define _mm256_roti_epi32(r, c) ( \
+                (8==-(c)) ? _mm256_shuffle_epi8(r,r8) \
+              : (16==-(c)) ? _mm256_shuffle_epi8(r,r16) \
+              : _mm256_xor_si256(_mm256_srli_epi32( (r), -(c) ),_mm256_slli_epi32( (r), 32-(-(c)) )) )
+#define _mm256_xor3_si256(a, b, c) _mm256_xor_si256((a), _mm256_xor_si256((b), (c)))
+#endif
+
+#define LANES_G(a,b,c,d,x,y) \
+  a = _mm256_add_epi32(_mm256_add_epi32(a, b), x); \
+  d = _mm256_xor_si256(d, a); \
+  d = _mm256_roti_epi32(d, -16); \
+  c = _mm256_add_epi32(c, d); \
+  b = _mm256_xor_si256(b, c); \
+  b = _mm256_roti_epi32(b, -12); \
+  a = _mm256_add_epi32(_mm256_add_epi32(a, b), y); \
+  d = _mm256_xor_si256(d, a); \
+  d = _mm256_roti_epi32(d, -8); \
+  c = _mm256_add_epi32(c, d); \
+  b = _mm256_xor_si256(b, c); \
+  b = _mm256_roti_epi32(b, -7);
+
+#define LANES_ROUND(r) \
+  LANES_G(v[ 0],v[ 4],v[ 8],v[12],m[blake2s_sigma[r][ 0]],m[blake2s_sigma[r][ 1]]); \
+  LANES_G(v[ 1],v[ 5],v[ 9],v[13],m[blake2s_sigma[r][ 2]],m[blake2s_sigma[r][ 3]]); \
+  LANES_G(v[ 2],v[ 6],v[10],v[14],m[blake2s_sigma[r][ 4]],m[blake2s_sigma[r][ 5]]); \
+  LANES_G(v[ 3],v[ 7],v[11],v[15],m[blake2s_sigma[r][ 6]],m[blake2s_sigma[r][ 7]]); \
+  LANES_G(v[ 0],v[ 5],v[10],v[15],m[blake2s_sigma[r][ 8]],m[blake2s_sigma[r][ 9]]); \
+  LANES_G(v[ 1],v[ 6],v[11],v[12],m[blake2s_sigma[r][10]],m[blake2s_sigma[r][11]]); \
+  LANES_G(v[ 2],v[ 7],v[ 8],v[13],m[blake2s_sigma[r][12]],m[blake2s_sigma[r][13]]); \
+  LANES_G(v[ 3],v[ 4],v[ 9],v[14],m[blake2s_sigma[r][14]],m[blake2s_sigma[r][15]]);
+
+/* transposes the message blocks of eight lanes into vertical layout */
+#define LANES_LOAD_MSG(m, blocks) \
+  for( j = 0; j < 2; ++j ) \
+  { \
+    const __m256i t0 = _mm256_unpacklo_epi32( LOADU256( (blocks)[0] + 32 * j ), LOADU256( (blocks)[1] + 32 * j ) ); \
+    const __m256i t1 = _mm256_unpackhi_epi32( LOADU256( (blocks)[0] + 32 * j ), LOADU256( (blocks)[1] + 32 * j ) ); \
+    const __m256i t2 = _mm256_unpacklo_epi32( LOADU256( (blocks)[2] + 32 * j ), LOADU256( (blocks)[3] + 32 * j ) ); \
+    const __m256i t3 = _mm256_unpackhi_epi32( LOADU256( (blocks)[2] + 32 * j ), LOADU256( (blocks)[3] + 32 * j ) ); \
+    const __m256i t4 = _mm256_unpacklo_epi32( LOADU256( (blocks)[4] + 32 * j ), LOADU256( (blocks)[5] + 32 * j ) ); \
+    const __m256i t5 = _mm256_unpackhi_epi32( LOADU256( (blocks)[4] + 32 * j ), LOADU256( (blocks)[5] + 32 * j ) ); \
+    const __m256i t6 = _mm256_unpacklo_epi32( LOADU256( (blocks)[6] + 32 * j ), LOADU256( (blocks)[7] + 32 * j ) ); \
+    const __m256i t7 = _mm256_unpackhi_epi32( LOADU256( (blocks)[6] + 32 * j ), LOADU256( (blocks)[7] + 32 * j ) ); \
+    const __m256i u0 = _mm256_unpacklo_epi64( t0, t2 ); \
+    const __m256i u1 = _mm256_unpackhi_epi64( t0, t2 ); \
+    const __m256i u2 = _mm256_unpacklo_epi64( t1, t3 ); \
+    const __m256i u3 = _mm256_unpackhi_epi64( t1, t3 ); \
+    const __m256i u4 = _mm256_unpacklo_epi64( t4, t6 ); \
+    const __m256i u5 = _mm256_unpackhi_epi64( t4, t6 ); \
+    const __m256i u6 = _mm256_unpacklo_epi64( t5, t7 ); \
+    const __m256i u7 = _mm256_unpackhi_epi64( t5, t7 ); \
+    m[8 * j + 0] = _mm256_permute2x128_si256( u0, u4, 0x20 ); \
+    m[8 * j + 1] = _mm256_permute2x128_si256( u1, u5, 0x20 ); \
+    m[8 * j + 2] = _mm256_permute2x128_si256( u2, u6, 0x20 ); \
+    m[8 * j + 3] = _mm256_permute2x128_si256( u3, u7, 0x20 ); \
+    m[8 * j + 4] = _mm256_permute2x128_si256( u0, u4, 0x31 ); \
+    m[8 * j + 5] = _mm256_permute2x128_si256( u1, u5, 0x31 ); \
+    m[8 * j + 6] = _mm256_permute2x128_si256( u2, u6, 0x31 ); \
+    m[8 * j + 7] = _mm256_permute2x128_si256( u3, u7, 0x31 ); \
+  }
+
+#define LANES_SET1(w) _mm256_set1_epi32( (int)(w) )
+
+#endif
@@ -0,0 +1,135 @@
+/*
+   BLAKE2 reference source code package - optimized C implementations
+
+   Copyright 2012, Samuel Neves <sneves@dei.uc.pt>.  You may use this under the
+   terms of the CC0, the OpenSSL Licence, or the Apache Public License 2.0, at
+   your option.  The terms of these licenses can be found at:
+
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+   - OpenSSL license   : https://www.openssl.org/source/license.html
+   - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+
+   More information about the BLAKE2 hash function can be found at
+   https://blake2.net.
+*/
+
+#include <stdint.h>
+
+#include "blake2.h"
+#include "blake2-impl.h"
+
+#include "blake2s-common.c.inc"
+#include "blake2sp-common.c.inc"
+#include "blake2s-many.c.inc"
+#include "blake2xs-common.c.inc"
+
+#include "blake2-x86-config.h"
+
+#include <emmintrin.h>
+#if defined(HAVE_SSSE3)
+#include <tmmintrin.h>
+#endif
+#if defined(HAVE_SSE41)
+#include <smmintrin.h>
+#endif
+#if defined(HAVE_AVX)
+#include <immintrin.h>
+#endif
+#if defined(HAVE_XOP)
+#include <x86intrin.h>
+#endif
+
+#include "blake2s-x86-round.h"
+#include "blake2s-avx2-lanes.h"
+
+static void blake2s_compress( blake2s_state *S, const uint8_t block[BLAKE2S_BLOCKBYTES] )
+{
+  __m128i row1, row2, row3, row4;
+  __m128i buf1, buf2, buf3, buf4;
+#if defined(HAVE_SSE41)
+  __m128i t0, t1, t2;
+#endif
+  __m128i ff0, ff1;
+#if defined(HAVE_SSSE3) && !defined(HAVE_XOP) && !defined(HAVE_AVX512VL)
+  const __m128i r8 = _mm_set_epi8( 12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1 );
+  const __m128i r16 = _mm_set_epi8( 13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2 );
+#endif
+#if defined(HAVE_SSE41)
+  const __m128i m0 = LOADU( block +  00 );
+  const __m128i m1 = LOADU( block +  16 );
+  const __m128i m2 = LOADU( block +  32 );
+  const __m128i m3 = LOADU( block +  48 );
+#else
+  const uint32_t  m0 = load32(block +  0 * sizeof(uint32_t));
+  const uint32_t  m1 = load32(block +  1 * sizeof(uint32_t));
+  const uint32_t  m2 = load32(block +  2 * sizeof(uint32_t));
+  const uint32_t  m3 = load32(block +  3 * sizeof(uint32_t));
+  const uint32_t  m4 = load32(block +  4 * sizeof(uint32_t));
+  const uint32_t  m5 = load32(block +  5 * sizeof(uint32_t));
+  const uint32_t  m6 = load32(block +  6 * sizeof(uint32_t));
+  const uint32_t  m7 = load32(block +  7 * sizeof(uint32_t));
+  const uint32_t  m8 = load32(block +  8 * sizeof(uint32_t));
+  const uint32_t  m9 = load32(block +  9 * sizeof(uint32_t));
+  const uint32_t m10 = load32(block + 10 * sizeof(uint32_t));
+  const uint32_t m11 = load32(block + 11 * sizeof(uint32_t));
+  const uint32_t m12 = load32(block + 12 * sizeof(uint32_t));
+  const uint32_t m13 = load32(block + 13 * sizeof(uint32_t));
+  const uint32_t m14 = load32(block + 14 * sizeof(uint32_t));
+  const uint32_t m15 = load32(block + 15 * sizeof(uint32_t));
+#endif
+  row1 = ff0 = LOADU( &S->h[0] );
+  row2 = ff1 = LOADU( &S->h[4] );
+  row3 = _mm_loadu_si128( (__m128i const *)&blake2s_IV[0] );
+  row4 = _mm_xor_si128( _mm_loadu_si128( (__m128i const *)&blake2s_IV[4] ), LOADU( &S->t[0] ) );
+  ROUND( 0 );
+  ROUND( 1 );
+  ROUND( 2 );
+  ROUND( 3 );
+  ROUND( 4 );
+  ROUND( 5 );
+  ROUND( 6 );
+  ROUND( 7 );
+  ROUND( 8 );
+  ROUND( 9 );
+  STOREU( &S->h[0], _mm_xor_si128( ff0, _mm_xor_si128( row1, row3 ) ) );
+  STOREU( &S->h[4], _mm_xor_si128( ff1, _mm_xor_si128( row2, row4 ) ) );
+}
+
+static_assert(BLAKE2S_LANES == 8, "the AVX2 lane kernel processes all lanes in one pass");
+
+static void blake2s_compress_lanes( blake2s_lanes *L, const uint8_t *const blocks[BLAKE2S_LANES] )
+{
+#if !defined(HAVE_AVX512VL)
+  const __m256i r8 = _mm256_set_epi8( 12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1,
+                                      12, 15, 14, 13, 8, 11, 10, 9, 4, 7, 6, 5, 0, 3, 2, 1 );
+  const __m256i r16 = _mm256_set_epi8( 13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+                                       13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2 );
+#endif
+  __m256i m[16];
+  __m256i v[16];
+  size_t j;
+
+  LANES_LOAD_MSG( m, blocks );
+  for( j = 0; j < 8; ++j )
+    v[j] = LOADU256( &L->h[j][0] );
+  v[ 8] = LANES_SET1( blake2s_IV[0] );
+  v[ 9] = LANES_SET1( blake2s_IV[1] );
+  v[10] = LANES_SET1( blake2s_IV[2] );
+  v[11] = LANES_SET1( blake2s_IV[3] );
+  v[12] = _mm256_xor_si256( LANES_SET1( blake2s_IV[4] ), LOADU256( &L->t[0][0] ) );
+  v[13] = _mm256_xor_si256( LANES_SET1( blake2s_IV[5] ), LOADU256( &L->t[1][0] ) );
+  v[14] = _mm256_xor_si256( LANES_SET1( blake2s_IV[6] ), LOADU256( &L->f[0][0] ) );
+  v[15] = _mm256_xor_si256( LANES_SET1( blake2s_IV[7] ), LOADU256( &L->f[1][0] ) );
+  LANES_ROUND( 0 );
+  LANES_ROUND( 1 );
+  LANES_ROUND( 2 );
+  LANES_ROUND( 3 );
+  LANES_ROUND( 4 );
+  LANES_ROUND( 5 );
+  LANES_ROUND( 6 );
+  LANES_ROUND( 7 );
+  LANES_ROUND( 8 );
+  LANES_ROUND( 9 );
+  for( j = 0; j < 8; ++j )
+    STOREU256( &L->h[j][0], _mm256_xor3_si256( LOADU256( &L->h[j][0] ), v[j], v[j + 8] ) );
+}
@@ -20,20 +20,9 @@
 #include "blake2-impl.h"
 
 #include "blake2s-common.c.inc"
-
-static const uint8_t blake2s_sigma[10][16] =
-{
-  {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 } ,
-  { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 } ,
-  { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 } ,
-  {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 } ,
-  {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 } ,
-  {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 } ,
-  { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 } ,
-  { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 } ,
-  {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 } ,
-  { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13 , 0 } ,
-};
+#include "blake2sp-common.c.inc"
+#include "blake2s-many.c.inc"
+#include "blake2xs-common.c.inc"
 
 #define G(r,i,a,b,c,d)                      \
   do {                                      \
@@ -98,5 +87,29 @@ static void blake2s_compress( blake2s_state *S, const uint8_t in[BLAKE2S_BLOCKBY
   }
 }
 
+/* without vector registers there is nothing to gain from interleaving the
+   lanes, therefore they are simply compressed one after another */
+static void blake2s_compress_lanes( blake2s_lanes *L, const uint8_t *const blocks[BLAKE2S_LANES] )
+{
+  blake2s_state S[1];
+  size_t i, l;
+
+  for( l = 0; l < BLAKE2S_LANES; ++l ) {
+    for( i = 0; i < 8; ++i ) {
+      S->h[i] = L->h[i][l];
+    }
+    S->t[0] = L->t[0][l];
+    S->t[1] = L->t[1][l];
+    S->f[0] = L->f[0][l];
+    S->f[1] = L->f[1][l];
+
+    blake2s_compress( S, blocks[l] );
+
+    for( i = 0; i < 8; ++i ) {
+      L->h[i][l] = S->h[i];
+    }
+  }
+}
+
 #undef G
 #undef ROUND
@@ -0,0 +1,61 @@
+/*
+   Deeplex libb2 multi-lane BLAKE2s round macros (NEON)
+
+   Copyright 2026, Henrik S. Gaßmann <henrik@gassmann.onl>
+
+   You may use this under the terms of the CC0, the OpenSSL Licence, or the
+   Apache Public License 2.0, at your option. The terms of these licenses can be
+   found at:
+
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+   - OpenSSL license   : https://www.openssl.org/source/license.html
+   - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+*/
+#ifndef BLAKE2S_LANES_H
+#define BLAKE2S_LANES_H
+
+/* Each register holds the same state word of four independent BLAKE2s
+   instances (lane interleaved / vertical layout), therefore no diagonalization
+   is required. Relies on the vrorq_n_u32_* macros from blake2s-neon-round.h. */
+
+#define LANES_G(a,b,c,d,x,y) \
+  a = vaddq_u32(vaddq_u32(a, b), x); \
+  d = veorq_u32(d, a); \
+  d = vrorq_n_u32_16(d); \
+  c = vaddq_u32(c, d); \
+  b = veorq_u32(b, c); \
+  b = vrorq_n_u32_12(b); \
+  a = vaddq_u32(vaddq_u32(a, b), y); \
+  d = veorq_u32(d, a); \
+  d = vrorq_n_u32_8(d); \
+  c = vaddq_u32(c, d); \
+  b = veorq_u32(b, c); \
+  b = vrorq_n_u32_7(b);
+
+#define LANES_ROUND(r) \
+  LANES_G(v[ 0],v[ 4],v[ 8],v[12],m[blake2s_sigma[r][ 0]],m[blake2s_sigma[r][ 1]]); \
+  LANES_G(v[ 1],v[ 5],v[ 9],v[13],m[blake2s_sigma[r][ 2]],m[blake2s_sigma[r][ 3]]); \
+  LANES_G(v[ 2],v[ 6],v[10],v[14],m[blake2s_sigma[r][ 4]],m[blake2s_sigma[r][ 5]]); \
+  LANES_G(v[ 3],v[ 7],v[11],v[15],m[blake2s_sigma[r][ 6]],m[blake2s_sigma[r][ 7]]); \
+  LANES_G(v[ 0],v[ 5],v[10],v[15],m[blake2s_sigma[r][ 8]],m[blake2s_sigma[r][ 9]]); \
+  LANES_G(v[ 1],v[ 6],v[11],v[12],m[blake2s_sigma[r][10]],m[blake2s_sigma[r][11]]); \
+  LANES_G(v[ 2],v[ 7],v[ 8],v[13],m[blake2s_sigma[r][12]],m[blake2s_sigma[r][13]]); \
+  LANES_G(v[ 3],v[ 4],v[ 9],v[14],m[blake2s_sigma[r][14]],m[blake2s_sigma[r][15]]);
+
+/* transposes the message blocks of four lanes into vertical layout */
+#define LANES_LOAD_MSG(m, block0, block1, block2, block3) \
+  for( j = 0; j < 4; ++j ) \
+  { \
+    const uint32x4_t b0 = vreinterpretq_u32_u8( vld1q_u8( (block0) + 16 * j ) ); \
+    const uint32x4_t b1 = vreinterpretq_u32_u8( vld1q_u8( (block1) + 16 * j ) ); \
+    const uint32x4_t b2 = vreinterpretq_u32_u8( vld1q_u8( (block2) + 16 * j ) ); \
+    const uint32x4_t b3 = vreinterpretq_u32_u8( vld1q_u8( (block3) + 16 * j ) ); \
+    const uint32x4x2_t t01 = vtrnq_u32( b0, b1 ); \
+    const uint32x4x2_t t23 = vtrnq_u32( b2, b3 ); \
+    m[4 * j + 0] = vcombine_u32( vget_low_u32( t01.val[0] ), vget_low_u32( t23.val[0] ) ); \
+    m[4 * j + 1] = vcombine_u32( vget_low_u32( t01.val[1] ), vget_low_u32( t23.val[1] ) ); \
+    m[4 * j + 2] = vcombine_u32( vget_high_u32( t01.val[0] ), vget_high_u32( t23.val[0] ) ); \
+    m[4 * j + 3] = vcombine_u32( vget_high_u32( t01.val[1] ), vget_high_u32( t23.val[1] ) ); \
+  }
+
+#endif
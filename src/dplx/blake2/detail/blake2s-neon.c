@@ -20,8 +20,12 @@
 #include "blake2-impl.h"
 
 #include "blake2s-common.c.inc"
+#include "blake2sp-common.c.inc"
+#include "blake2s-many.c.inc"
+#include "blake2xs-common.c.inc"
 
 #include "blake2s-neon-round.h"
+#include "blake2s-neon-lanes.h"
 
 static void blake2s_compress( blake2s_state *S, const uint8_t in[BLAKE2S_BLOCKBYTES] )
 {
@@ -59,3 +63,37 @@ static void blake2s_compress( blake2s_state *S, const uint8_t in[BLAKE2S_BLOCKBY
   vst1q_u32(&S->h[0], veorq_u32(h1234, veorq_u32(row1, row3)));
   vst1q_u32(&S->h[4], veorq_u32(h5678, veorq_u32(row2, row4)));
 }
+
+static void blake2s_compress_lanes( blake2s_lanes *L, const uint8_t *const blocks[BLAKE2S_LANES] )
+{
+  uint32x4_t m[16];
+  uint32x4_t v[16];
+  size_t i, j;
+
+  for( i = 0; i < BLAKE2S_LANES; i += 4 )
+  {
+    LANES_LOAD_MSG( m, blocks[i], blocks[i + 1], blocks[i + 2], blocks[i + 3] );
+    for( j = 0; j < 8; ++j )
+      v[j] = vld1q_u32( &L->h[j][i] );
+    v[ 8] = vdupq_n_u32( blake2s_IV[0] );
+    v[ 9] = vdupq_n_u32( blake2s_IV[1] );
+    v[10] = vdupq_n_u32( blake2s_IV[2] );
+    v[11] = vdupq_n_u32( blake2s_IV[3] );
+    v[12] = veorq_u32( vdupq_n_u32( blake2s_IV[4] ), vld1q_u32( &L->t[0][i] ) );
+    v[13] = veorq_u32( vdupq_n_u32( blake2s_IV[5] ), vld1q_u32( &L->t[1][i] ) );
+    v[14] = veorq_u32( vdupq_n_u32( blake2s_IV[6] ), vld1q_u32( &L->f[0][i] ) );
+    v[15] = veorq_u32( vdupq_n_u32( blake2s_IV[7] ), vld1q_u32( &L->f[1][i] ) );
+    LANES_ROUND( 0 );
+    LANES_ROUND( 1 );
+    LANES_ROUND( 2 );
+    LANES_ROUND( 3 );
+    LANES_ROUND( 4 );
+    LANES_ROUND( 5 );
+    LANES_ROUND( 6 );
+    LANES_ROUND( 7 );
+    LANES_ROUND( 8 );
+    LANES_ROUND( 9 );
+    for( j = 0; j < 8; ++j )
+      vst1q_u32( &L->h[j][i], veorq_u32( vld1q_u32( &L->h[j][i] ), veorq_u32( v[j], v[j + 8] ) ) );
+  }
+}
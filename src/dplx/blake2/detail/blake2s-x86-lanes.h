@@ -0,0 +1,65 @@
+/*
+   Deeplex libb2 multi-lane BLAKE2s round macros (SSE2 / SSSE3 / SSE4.1 / AVX)
+
+   Copyright 2026, Henrik S. Gaßmann <henrik@gassmann.onl>
+
+   You may use this under the terms of the CC0, the OpenSSL Licence, or the
+   Apache Public License 2.0, at your option. The terms of these licenses can be
+   found at:
+
+   - CC0 1.0 Universal : http://creativecommons.org/publicdomain/zero/1.0
+   - OpenSSL license   : https://www.openssl.org/source/license.html
+   - Apache 2.0        : http://www.apache.org/licenses/LICENSE-2.0
+*/
+#ifndef BLAKE2S_LANES_H
+#define BLAKE2S_LANES_H
+
+/* Each register holds the same state word of four independent BLAKE2s
+   instances (lane interleaved / vertical layout), therefore no diagonalization
+   is required. Relies on _mm_roti_epi32 from blake2s-x86-round.h. */
+
+#define LANES_G(a,b,c,d,x,y) \
+  a = _mm_add_epi32(_mm_add_epi32(a, b), x); \
+  d = _mm_xor_si128(d, a); \
+  d = _mm_roti_epi32(d, -16); \
+  c = _mm_add_epi32(c, d); \
+  b = _mm_xor_si128(b, c); \
+  b = _mm_roti_epi32(b, -12); \
+  a = _mm_add_epi32(_mm_add_epi32(a, b), y); \
+  d = _mm_xor_si128(d, a); \
+  d = _mm_roti_epi32(d, -8); \
+  c = _mm_add_epi32(c, d); \
+  b = _mm_xor_si128(b, c); \
+  b = _mm_roti_epi32(b, -7);
+
+#define LANES_ROUND(r) \
+  LANES_G(v[ 0],v[ 4],v[ 8],v[12],m[blake2s_sigma[r][ 0]],m[blake2s_sigma[r][ 1]]); \
+  LANES_G(v[ 1],v[ 5],v[ 9],v[13],m[blake2s_sigma[r][ 2]],m[blake2s_sigma[r][ 3]]); \
+  LANES_G(v[ 2],v[ 6],v[10],v[14],m[blake2s_sigma[r][ 4]],m[blake2s_sigma[r][ 5]]); \
+  LANES_G(v[ 3],v[ 7],v[11],v[15],m[blake2s_sigma[r][ 6]],m[blake2s_sigma[r][ 7]]); \
+  LANES_G(v[ 0],v[ 5],v[10],v[15],m[blake2s_sigma[r][ 8]],m[blake2s_sigma[r][ 9]]); \
+  LANES_G(v[ 1],v[ 6],v[11],v[12],m[blake2s_sigma[r][10]],m[blake2s_sigma[r][11]]); \
+  LANES_G(v[ 2],v[ 7],v[ 8],v[13],m[blake2s_sigma[r][12]],m[blake2s_sigma[r][13]]); \
+  LANES_G(v[ 3],v[ 4],v[ 9],v[14],m[blake2s_sigma[r][14]],m[blake2s_sigma[r][15]]);
+
+/* transposes the message blocks of four lanes into vertical layout */
+#define LANES_LOAD_MSG(m, block0, block1, block2, block3) \
+  for( j = 0; j < 4; ++j ) \
+  { \
+    const __m128i b0 = LOADU( (block0) + 16 * j ); \
+    const __m128i b1 = LOADU( (block1) + 16 * j ); \
+    const __m128i b2 = LOADU( (block2) + 16 * j ); \
+    const __m128i b3 = LOADU( (block3) + 16 * j ); \
+    const __m128i t0 = _mm_unpacklo_epi32( b0, b1 ); \
+    const __m128i t1 = _mm_unpacklo_epi32( b2, b3 ); \
+    const __m128i t2 = _mm_unpackhi_epi32( b0, b1 ); \
+    const __m128i t3 = _mm_unpackhi_epi32( b2, b3 ); \
+    m[4 * j + 0] = _mm_unpacklo_epi64( t0, t1 ); \
+    m[4 * j + 1] = _mm_unpackhi_epi64( t0, t1 ); \
+    m[4 * j + 2] = _mm_unpacklo_epi64( t2, t3 ); \
+    m[4 * j + 3] = _mm_unpackhi_epi64( t2, t3 ); \
+  }
+
+#define LANES_SET1(w) _mm_set1_epi32( (int)(w) )
+
+#endif
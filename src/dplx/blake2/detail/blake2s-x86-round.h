@@ -25,7 +25,9 @@
 
 
 /* Microarchitecture-specific macros */
-#ifndef HAVE_XOP
+#if defined(HAVE_AVX512VL)
+#define _mm_roti_epi32(r, c) _mm_ror_epi32((r), -(c))
+#elif !defined(HAVE_XOP)
 #ifdef HAVE_SSSE3
 #define _mm_roti_epi32(r, c) ( \
                 (8==-(c)) ? _mm_shuffle_epi8(r,r8) \
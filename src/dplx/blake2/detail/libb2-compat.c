@@ -22,6 +22,23 @@ int blake2s_final( blake2s_state *S, void *out, size_t outlen )
     return dplx_blake2s_final(S, out, outlen);
 }
 
+int blake2sp_init( blake2sp_state *S, size_t outlen )
+{
+    return dplx_blake2sp_init(S, outlen);
+}
+int blake2sp_init_key( blake2sp_state *S, size_t outlen, const void *key, size_t keylen )
+{
+    return dplx_blake2sp_init_key(S, outlen, key, keylen);
+}
+int blake2sp_update( blake2sp_state *S, const void *in, size_t inlen )
+{
+    return dplx_blake2sp_update(S, in, inlen);
+}
+int blake2sp_final( blake2sp_state *S, void *out, size_t outlen )
+{
+    return dplx_blake2sp_final(S, out, outlen);
+}
+
 int blake2b_init( blake2b_state *S, size_t outlen )
 {
     return dplx_blake2b_init(S, outlen);
@@ -43,6 +60,23 @@ int blake2b_final( blake2b_state *S, void *out, size_t outlen )
     return dplx_blake2b_final(S, out, outlen);
 }
 
+int blake2bp_init( blake2bp_state *S, size_t outlen )
+{
+    return dplx_blake2bp_init(S, outlen);
+}
+int blake2bp_init_key( blake2bp_state *S, size_t outlen, const void *key, size_t keylen )
+{
+    return dplx_blake2bp_init_key(S, outlen, key, keylen);
+}
+int blake2bp_update( blake2bp_state *S, const void *in, size_t inlen )
+{
+    return dplx_blake2bp_update(S, in, inlen);
+}
+int blake2bp_final( blake2bp_state *S, void *out, size_t outlen )
+{
+    return dplx_blake2bp_final(S, out, outlen);
+}
+
 int blake2xs_init( blake2xs_state *S, const size_t outlen )
 {
     return dplx_blake2xs_init(S, outlen);
@@ -87,6 +121,15 @@ int blake2b( void *out, size_t outlen, const void *in, size_t inlen, const void
     return dplx_blake2b(out, outlen, in, inlen, key, keylen);
 }
 
+int blake2sp( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen )
+{
+    return dplx_blake2sp(out, outlen, in, inlen, key, keylen);
+}
+int blake2bp( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen )
+{
+    return dplx_blake2bp(out, outlen, in, inlen, key, keylen);
+}
+
 int blake2xs( void *out, size_t outlen, const void *in, size_t inlen, const void *key, size_t keylen )
 {
     return dplx_blake2xs(out, outlen, in, inlen, key, keylen);